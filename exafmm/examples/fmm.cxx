@@ -20,10 +20,10 @@ void run_fmm(const Args& args) {
 
   my_ityr::logger::init(my_rank, n_ranks);
 
-  global_vec<Body> bodies_vec(global_vec_coll_opts);
-  global_vec<Body> jbodies_vec(global_vec_coll_opts);
-  global_vec<Body> buffer_vec(global_vec_coll_opts);
-  global_vec<Cell> cells_vec(global_vec_coll_opts);
+  global_vec<Body> bodies_vec(global_vec_body_opts);
+  global_vec<Body> jbodies_vec(global_vec_body_opts);
+  global_vec<Body> buffer_vec(global_vec_body_opts);
+  global_vec<Cell> cells_vec(global_vec_cell_opts);
 
   GBodies bodies, jbodies, buffer;
   BoundBox boundBox;
@@ -281,7 +281,7 @@ namespace EXAFMM_NAMESPACE {
         logger::startTimer("Link tree");                          // Start timer
       }
 
-      global_vec<Cell> cells_vec(global_vec_coll_opts);                                              // Initialize cell array
+      global_vec<Cell> cells_vec(global_vec_cell_opts);                                              // Initialize cell array
 
       if (N0 != nullptr) {                                         // If the node tree is not empty
         /* std::size_t ncells = N0->*(&OctreeNode::NNODE); */
@@ -94,36 +94,29 @@ namespace EXAFMM_NAMESPACE {
 
     //! Split cell and call traverse() recursively for child
     void splitCell(GC_iter Ci, GC_iter Cj, real_t remote) {
-      int nchild_i = Ci->*(static_cast<int Cell::*>(&CellBase::NCHILD));
-      int nchild_j = Cj->*(static_cast<int Cell::*>(&CellBase::NCHILD));
+      auto [nchild_i, ichild_i, nbody_i, r_i] =
+        my_ityr::fetch_fields(Ci, &CellBase::NCHILD, &CellBase::ICHILD, &CellBase::NBODY, &CellBase::R);
+      auto [nchild_j, ichild_j, nbody_j, r_j] =
+        my_ityr::fetch_fields(Cj, &CellBase::NCHILD, &CellBase::ICHILD, &CellBase::NBODY, &CellBase::R);
       if (nchild_j == 0) {                                    // If Cj is leaf
 	assert(nchild_i > 0);                                 //  Make sure Ci is not leaf
-        int ichild_i = Ci->*(static_cast<int Cell::*>(&CellBase::ICHILD));
-        // TODO: bulk checkout?
 	for (GC_iter ci=Ci0+ichild_i; ci!=Ci0+ichild_i+nchild_i; ci++) {// Loop over Ci's children
 	  dualTreeTraversal(ci, Cj, remote);                    //   Traverse a single pair of cells
 	}                                                       //  End loop over Ci's children
       } else if (nchild_i == 0) {                             // Else if Ci is leaf
 	assert(nchild_j > 0);                                 //  Make sure Cj is not leaf
-        int ichild_j = Cj->*(static_cast<int Cell::*>(&CellBase::ICHILD));
 	for (GC_iter cj=Cj0+ichild_j; cj!=Cj0+ichild_j+nchild_j; cj++) {// Loop over Cj's children
 	  dualTreeTraversal(Ci, cj, remote);                    //   Traverse a single pair of cells
 	}                                                       //  End loop over Cj's children
-      } else if (Ci->*(static_cast<int Cell::*>(&CellBase::NBODY)) +
-                 Cj->*(static_cast<int Cell::*>(&CellBase::NBODY)) >= nspawn || (Ci == Cj)) {// Else if cells are still large
-        int ichild_i = Ci->*(static_cast<int Cell::*>(&CellBase::ICHILD));
-        int ichild_j = Cj->*(static_cast<int Cell::*>(&CellBase::ICHILD));
+      } else if (nbody_i + nbody_j >= nspawn || (Ci == Cj)) {  // Else if cells are still large
 	TraverseRange traverseRange(this, Ci0+ichild_i, Ci0+ichild_i+nchild_i,// Instantiate recursive functor
 				    Cj0+ichild_j, Cj0+ichild_j+nchild_j, remote);
 	traverseRange();                                        //  Traverse for range of cell pairs
-      } else if (Ci->*(static_cast<real_t Cell::*>(&CellBase::R)) >=
-                 Cj->*(static_cast<real_t Cell::*>(&CellBase::R))) {                              // Else if Ci is larger than Cj
-        int ichild_i = Ci->*(static_cast<int Cell::*>(&CellBase::ICHILD));
+      } else if (r_i >= r_j) {                                  // Else if Ci is larger than Cj
 	for (GC_iter ci=Ci0+ichild_i; ci!=Ci0+ichild_i+nchild_i; ci++) {// Loop over Ci's children
 	  dualTreeTraversal(ci, Cj, remote);                    //   Traverse a single pair of cells
 	}                                                       //  End loop over Ci's children
       } else {                                                  // Else if Cj is larger than Ci
-        int ichild_j = Cj->*(static_cast<int Cell::*>(&CellBase::ICHILD));
 	for (GC_iter cj=Cj0+ichild_j; cj!=Cj0+ichild_j+nchild_j; cj++) {// Loop over Cj's children
 	  dualTreeTraversal(Ci, cj, remote);                    //   Traverse a single pair of cells
 	}                                                       //  End loop over Cj's children
@@ -132,13 +125,12 @@ namespace EXAFMM_NAMESPACE {
 
     //! Dual tree traversal for a single pair of cells
     void dualTreeTraversal(GC_iter Ci, GC_iter Cj, real_t remote) {
-      int nchild_i = Ci->*(static_cast<int Cell::*>(&CellBase::NCHILD));
-      int nchild_j = Cj->*(static_cast<int Cell::*>(&CellBase::NCHILD));
-      vec3 dX = vec3(Ci->*(static_cast<vec3 Cell::*>(&CellBase::X))) -
-                vec3(Cj->*(static_cast<vec3 Cell::*>(&CellBase::X))) - kernel.Xperiodic;               // Distance vector from source to target
+      auto [nchild_i, Xi, Ri] =
+        my_ityr::fetch_fields(Ci, &CellBase::NCHILD, &CellBase::X, &CellBase::R);
+      auto [nchild_j, nbody_j, Xj, Rj] =
+        my_ityr::fetch_fields(Cj, &CellBase::NCHILD, &CellBase::NBODY, &CellBase::X, &CellBase::R);
+      vec3 dX = Xi - Xj - kernel.Xperiodic;                     // Distance vector from source to target
       real_t RT2 = norm(dX) * theta * theta;                    // Scalar distance squared
-      real_t Ri = Ci->*(static_cast<real_t Cell::*>(&CellBase::R));
-      real_t Rj = Cj->*(static_cast<real_t Cell::*>(&CellBase::R));
       if (RT2 > (Ri+Rj) * (Ri+Rj) * (1 - 1e-3)) {   // If distance is far enough
         my_ityr::with_checkout_tied<my_ityr::access_mode::read,
                                     my_ityr::access_mode::read>(
@@ -178,7 +170,7 @@ namespace EXAFMM_NAMESPACE {
 	}
 #endif
 #endif
-	if (Cj->*(static_cast<int Cell::*>(&CellBase::NBODY)) == 0) {                                   //  If the bodies weren't sent from remote node
+	if (nbody_j == 0) {                                     //  If the bodies weren't sent from remote node
 	  //std::cout << "Warning: icell " << Ci->ICELL << " needs bodies from jcell" << Cj->ICELL << std::endl;
           my_ityr::with_checkout_tied<my_ityr::access_mode::read,
                                       my_ityr::access_mode::read>(
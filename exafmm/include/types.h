@@ -30,6 +30,24 @@ namespace EXAFMM_NAMESPACE {
     .cutoff             = my_ityr::iro::block_size,
   };
 
+  // Bodies are sorted and traversed in contiguous ranges, so they are block-distributed
+  inline constexpr ityr::global_vector_options global_vec_body_opts {
+    .collective         = true,
+    .parallel_construct = true,
+    .parallel_destruct  = true,
+    .cutoff             = my_ityr::iro::block_size,
+    .dist               = ityr::distribution::block(),
+  };
+
+  // Cells are accessed irregularly during traversals, so they are spread cyclically
+  inline constexpr ityr::global_vector_options global_vec_cell_opts {
+    .collective         = true,
+    .parallel_construct = true,
+    .parallel_destruct  = true,
+    .cutoff             = my_ityr::iro::block_size,
+    .dist               = ityr::distribution::cyclic(),
+  };
+
   // Basic type definitions
 #if EXAFMM_SINGLE
   typedef float real_t;                                         //!< Floating point type is single precision
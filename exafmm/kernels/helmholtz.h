@@ -798,100 +798,102 @@ namespace EXAFMM_NAMESPACE {
 	ephi[P+n] = ephi[P+n-1] * ephi[P+1];
 	ephi[P-n] = conj(ephi[P+n]);
       }
-      my_ityr::with_checkout_tied<my_ityr::access_mode::read_write,
-                                  my_ityr::access_mode::read>(
-          Ci->L.data(), Ci->L.size(), Cj->M.data(), Cj->M.size(),
-          [&](complex_t* CiL, const complex_t* CjM) {
-        for (int n=0; n<Popt; n++) {
-          for (int m=-n; m<=n; m++) {
-            int nm = n * n + n + m;
-            Mnm[nm] = CjM[nm] * ephi[P+m];
-          }
-        }
-        rotate(theta, Popt, Mnm, Mrot);
-        for (int l=0; l<nquad; l++) {
-          real_t ctheta = xquad[l];
-          real_t stheta = sqrt(1 - ctheta * ctheta);
-          real_t rj = (r + radius * ctheta) * (r + radius * ctheta) + (radius * stheta) * (radius * stheta);
-          rj = sqrt(rj);
-          real_t cthetaj = (r + radius * ctheta) / rj;
-          real_t sthetaj = sqrt(1 - cthetaj * cthetaj);
-          real_t rn = sthetaj * stheta + cthetaj * ctheta;
-          real_t thetan = (cthetaj * stheta - ctheta * sthetaj) / rj;
-          complex_t z = wavek * rj;
-          get_Ynmd(Popt, cthetaj, Ynm, Ynmd);
-          get_hnd(Popt, z, kscalej, hn, hnd);
+      // M2L tasks for different Cj may update the same Ci->L concurrently
+      my_ityr::with_accumulate(Ci->L.data(), Ci->L.size(), [&](complex_t* CiL) {
+        my_ityr::with_checkout_tied<my_ityr::access_mode::read>(
+            Cj->M.data(), Cj->M.size(),
+            [&](const complex_t* CjM) {
           for (int n=0; n<Popt; n++) {
-            hnd[n] *= wavek;
-          }
-          for (int n=1; n<Popt; n++) {
-            for (int m=1; m<=n; m++) {
-              int nms = n * (n + 1) / 2 + m;
-              Ynm[nms] *= sthetaj;
+            for (int m=-n; m<=n; m++) {
+              int nm = n * n + n + m;
+              Mnm[nm] = CjM[nm] * ephi[P+m];
             }
           }
-          for (int m=-Popt+1; m<Popt; m++) {
-            phitemp[Popt+m] = 0;
-            phitempn[Popt+m] = 0;
-          }
-          phitemp[Popt] = Mrot[0] * hn[0];
-          phitempn[Popt] = Mrot[0] * hnd[0] * rn;
-          for (int n=1; n<Popt; n++) {
-            int nm = n * n + n;
-            int nms = n * (n + 1) / 2;
-            phitemp[Popt] += Mrot[nm] * hn[n] * Ynm[nms];
-            complex_t ut1 = hnd[n] * rn;
-            complex_t ut2 = hn[n] * thetan;
-            complex_t ut3 = ut1 * Ynm[nms] - ut2 * Ynmd[nms] * sthetaj;
-            phitempn[Popt] += ut3 * Mrot[nm];
-            for (int m=1; m<=n; m++) {
-              nms = n * (n + 1) / 2 + m;
-              int npm = n * n + n + m;
-              int nmm = n * n + n - m;
-              z = hn[n] * Ynm[nms];
-              phitemp[Popt+m] += Mrot[npm] * z;
-              phitemp[Popt-m] += Mrot[nmm] * z;
-              ut3 = ut1 * Ynm[nms] - ut2 * Ynmd[nms];
-              phitempn[Popt+m] += ut3 * Mrot[npm];
-              phitempn[Popt-m] += ut3 * Mrot[nmm];
+          rotate(theta, Popt, Mnm, Mrot);
+          for (int l=0; l<nquad; l++) {
+            real_t ctheta = xquad[l];
+            real_t stheta = sqrt(1 - ctheta * ctheta);
+            real_t rj = (r + radius * ctheta) * (r + radius * ctheta) + (radius * stheta) * (radius * stheta);
+            rj = sqrt(rj);
+            real_t cthetaj = (r + radius * ctheta) / rj;
+            real_t sthetaj = sqrt(1 - cthetaj * cthetaj);
+            real_t rn = sthetaj * stheta + cthetaj * ctheta;
+            real_t thetan = (cthetaj * stheta - ctheta * sthetaj) / rj;
+            complex_t z = wavek * rj;
+            get_Ynmd(Popt, cthetaj, Ynm, Ynmd);
+            get_hnd(Popt, z, kscalej, hn, hnd);
+            for (int n=0; n<Popt; n++) {
+              hnd[n] *= wavek;
+            }
+            for (int n=1; n<Popt; n++) {
+              for (int m=1; m<=n; m++) {
+                int nms = n * (n + 1) / 2 + m;
+                Ynm[nms] *= sthetaj;
+              }
+            }
+            for (int m=-Popt+1; m<Popt; m++) {
+              phitemp[Popt+m] = 0;
+              phitempn[Popt+m] = 0;
+            }
+            phitemp[Popt] = Mrot[0] * hn[0];
+            phitempn[Popt] = Mrot[0] * hnd[0] * rn;
+            for (int n=1; n<Popt; n++) {
+              int nm = n * n + n;
+              int nms = n * (n + 1) / 2;
+              phitemp[Popt] += Mrot[nm] * hn[n] * Ynm[nms];
+              complex_t ut1 = hnd[n] * rn;
+              complex_t ut2 = hn[n] * thetan;
+              complex_t ut3 = ut1 * Ynm[nms] - ut2 * Ynmd[nms] * sthetaj;
+              phitempn[Popt] += ut3 * Mrot[nm];
+              for (int m=1; m<=n; m++) {
+                nms = n * (n + 1) / 2 + m;
+                int npm = n * n + n + m;
+                int nmm = n * n + n - m;
+                z = hn[n] * Ynm[nms];
+                phitemp[Popt+m] += Mrot[npm] * z;
+                phitemp[Popt-m] += Mrot[nmm] * z;
+                ut3 = ut1 * Ynm[nms] - ut2 * Ynmd[nms];
+                phitempn[Popt+m] += ut3 * Mrot[npm];
+                phitempn[Popt-m] += ut3 * Mrot[nmm];
+              }
+            }
+            get_Ynm(Popt, xquad[l], Ynm);
+            for (int m=-Popt+1; m<Popt; m++) {
+              int mabs = abs(m);
+              z = phitemp[Popt+m] * wquad[l] * real_t(.5);
+              for (int n=mabs; n<Popt; n++) {
+                int nm = n * n + n + m;
+                int nms = n * (n + 1) / 2 + mabs;
+                Lnm[nm] += z * Ynm[nms];
+              }
+              z = phitempn[Popt+m] * wquad[l] * real_t(.5);
+              for (int n=mabs; n<Popt; n++) {
+                int nm = n * n + n + m;
+                int nms = n * (n + 1) / 2 + mabs;
+                Lnmd[nm] += z * Ynm[nms];
+              }
             }
           }
-          get_Ynm(Popt, xquad[l], Ynm);
-          for (int m=-Popt+1; m<Popt; m++) {
-            int mabs = abs(m);
-            z = phitemp[Popt+m] * wquad[l] * real_t(.5);
-            for (int n=mabs; n<Popt; n++) {
+          complex_t z = wavek * radius;
+          get_jn(Popt, z, kscalei, jn, 1, jnd);
+          for (int n=0; n<Popt; n++) {
+            for (int m=-n; m<=n; m++) {
               int nm = n * n + n + m;
-              int nms = n * (n + 1) / 2 + mabs;
-              Lnm[nm] += z * Ynm[nms];
+              complex_t zh = jn[n];
+              complex_t zhn = jnd[n] * wavek;
+              z = zh * zh + zhn * zhn;
+              Lnm[nm] = (zh * Lnm[nm] + zhn * Lnmd[nm]) / z;
             }
-            z = phitempn[Popt+m] * wquad[l] * real_t(.5);
-            for (int n=mabs; n<Popt; n++) {
+          }
+          rotate(-theta, Popt, Lnm, Lrot);
+          for (int n=0; n<Popt; n++) {
+            for (int m=-n; m<=n; m++) {
               int nm = n * n + n + m;
-              int nms = n * (n + 1) / 2 + mabs;
-              Lnmd[nm] += z * Ynm[nms];
+              Lnm[nm] = ephi[P-m] * Lrot[nm];
             }
           }
-        }
-        complex_t z = wavek * radius;
-        get_jn(Popt, z, kscalei, jn, 1, jnd);
-        for (int n=0; n<Popt; n++) {
-          for (int m=-n; m<=n; m++) {
-            int nm = n * n + n + m;
-            complex_t zh = jn[n];
-            complex_t zhn = jnd[n] * wavek;
-            z = zh * zh + zhn * zhn;
-            Lnm[nm] = (zh * Lnm[nm] + zhn * Lnmd[nm]) / z;
-          }
-        }
-        rotate(-theta, Popt, Lnm, Lrot);
-        for (int n=0; n<Popt; n++) {
-          for (int m=-n; m<=n; m++) {
-            int nm = n * n + n + m;
-            Lnm[nm] = ephi[P-m] * Lrot[nm];
-          }
-        }
-        for (int n=0; n<P*P; n++) CiL[n] += Lnm[n];
+          for (int n=0; n<P*P; n++) CiL[n] += Lnm[n];
+        });
       });
     }
 
@@ -407,34 +407,36 @@ namespace EXAFMM_NAMESPACE {
       cart2sph(dX, rho, alpha, beta);
       evalLocal(rho, alpha, beta, Ynm2);
 
-      my_ityr::with_checkout_tied<my_ityr::access_mode::read_write,
-                                  my_ityr::access_mode::read>(
-          Ci->L.data(), Ci->L.size(), Cj->M.data(), Cj->M.size(),
-          [&](complex_t* CiL, const complex_t* CjM) {
-        for (int j=0; j<P; j++) {
-          for (int k=0; k<=j; k++) {
-            int jk = j * j + j + k;
-            int jks = j * (j + 1) / 2 + k;
-            complex_t L = 0;
-            for (int n=0; n<P; n++) {
-              for (int m=-n; m<0; m++) {
-                int nm   = n * n + n + m;
-                int nms  = n * (n + 1) / 2 - m;
-                int jknm = jk * P * P + nm;
-                int jnkm = (j + n) * (j + n) + j + n + m - k;
-                L += std::conj(CjM[nms]) * Cnm[jknm] * Ynm2[jnkm];
-              }
-              for (int m=0; m<=n; m++) {
-                int nm   = n * n + n + m;
-                int nms  = n * (n + 1) / 2 + m;
-                int jknm = jk * P * P + nm;
-                int jnkm = (j + n) * (j + n) + j + n + m - k;
-                L += CjM[nms] * Cnm[jknm] * Ynm2[jnkm];
+      // M2L tasks for different Cj may update the same Ci->L concurrently
+      my_ityr::with_accumulate(Ci->L.data(), Ci->L.size(), [&](complex_t* CiL) {
+        my_ityr::with_checkout_tied<my_ityr::access_mode::read>(
+            Cj->M.data(), Cj->M.size(),
+            [&](const complex_t* CjM) {
+          for (int j=0; j<P; j++) {
+            for (int k=0; k<=j; k++) {
+              int jk = j * j + j + k;
+              int jks = j * (j + 1) / 2 + k;
+              complex_t L = 0;
+              for (int n=0; n<P; n++) {
+                for (int m=-n; m<0; m++) {
+                  int nm   = n * n + n + m;
+                  int nms  = n * (n + 1) / 2 - m;
+                  int jknm = jk * P * P + nm;
+                  int jnkm = (j + n) * (j + n) + j + n + m - k;
+                  L += std::conj(CjM[nms]) * Cnm[jknm] * Ynm2[jnkm];
+                }
+                for (int m=0; m<=n; m++) {
+                  int nm   = n * n + n + m;
+                  int nms  = n * (n + 1) / 2 + m;
+                  int jknm = jk * P * P + nm;
+                  int jnkm = (j + n) * (j + n) + j + n + m - k;
+                  L += CjM[nms] * Cnm[jknm] * Ynm2[jnkm];
+                }
               }
+              CiL[jks] += L;
             }
-            CiL[jks] += L;
           }
-        }
+        });
       });
     }
 
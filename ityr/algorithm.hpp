@@ -0,0 +1,253 @@
+#pragma once
+
+#include <functional>
+#include <vector>
+
+#include "ityr/util.hpp"
+#include "ityr/iro.hpp"
+#include "ityr/ito_pattern.hpp"
+#include "ityr/container.hpp"
+
+namespace ityr {
+
+struct parallel_sort_options {
+  std::size_t cutoff_insert = 64;
+  std::size_t cutoff_merge  = 16 * 1024;
+  std::size_t cutoff_quick  = 16 * 1024;
+};
+
+// Cilksort (parallel mergesort) and its parallel merge, lifted from the cilksort benchmark.
+// Span can be either raw_span or global_span.
+template <typename P>
+class algorithm_if {
+  using iro = typename P::iro;
+  using ito_pattern = typename P::ito_pattern;
+  using global_container = typename P::global_container;
+  using access_mode = typename iro::access_mode;
+
+  template <template <typename> typename Span, typename T>
+  static auto divide(const Span<T>& s, typename Span<T>::size_type at) {
+    return std::make_pair(s.subspan(0, at), s.subspan(at, s.size() - at));
+  }
+
+  template <template <typename> typename Span, typename T>
+  static auto divide_two(const Span<T>& s) {
+    return divide(s, s.size() / 2);
+  }
+
+  template <template <typename> typename Span, typename T, typename Compare>
+  static T select_pivot(Span<const T> s, Compare comp) {
+    // median of three values
+    if (s.size() < 3) return s[0];
+    const T& a = s[0];
+    const T& b = s[1];
+    const T& c = s[2];
+    if (comp(b, a) != comp(c, a))      return a;
+    else if (comp(a, b) != comp(c, b)) return b;
+    else                               return c;
+  }
+
+  template <template <typename> typename Span, typename T, typename Compare>
+  static void insertion_sort(Span<T> s, Compare comp) {
+    for (std::size_t i = 1; i < s.size(); i++) {
+      T a = std::move(s[i]);
+      std::size_t j;
+      for (j = 1; j <= i && comp(a, s[i - j]); j++) {
+        s[i - j + 1] = std::move(s[i - j]);
+      }
+      s[i - j + 1] = std::move(a);
+    }
+  }
+
+  template <template <typename> typename Span, typename T, typename Compare>
+  static std::pair<Span<T>, Span<T>> partition_seq(Span<T> s, const T& pivot, Compare comp) {
+    std::size_t l = 0;
+    std::size_t h = s.size() - 1;
+    while (true) {
+      while (comp(s[l], pivot)) l++;
+      while (comp(pivot, s[h])) h--;
+      if (l >= h) break;
+      std::swap(s[l++], s[h--]);
+    }
+    return divide(s, h + 1);
+  }
+
+  template <template <typename> typename Span, typename T, typename Compare>
+  static void quicksort_seq(Span<T> s, Compare comp, const parallel_sort_options& opts) {
+    if (s.size() <= opts.cutoff_insert) {
+      insertion_sort(s, comp);
+    } else {
+      T pivot = select_pivot(Span<const T>(s), comp);
+      auto [s1, s2] = partition_seq(s, pivot, comp);
+      quicksort_seq(s1, comp, opts);
+      quicksort_seq(s2, comp, opts);
+    }
+  }
+
+  template <template <typename> typename Span, typename T, typename Compare>
+  static void merge_seq(Span<const T> s1, Span<const T> s2, Span<T> dest, Compare comp) {
+    assert(s1.size() + s2.size() == dest.size());
+
+    std::size_t d = 0;
+    std::size_t l1 = 0;
+    std::size_t l2 = 0;
+    while (true) {
+      if (comp(s2[l2], s1[l1])) {
+        dest[d++] = s2[l2++];
+        if (l2 >= s2.size()) break;
+      } else {
+        dest[d++] = s1[l1++];
+        if (l1 >= s1.size()) break;
+      }
+    }
+    if (l1 >= s1.size()) {
+      std::copy(s2.begin() + l2, s2.end(), dest.begin() + d);
+    } else {
+      std::copy(s1.begin() + l1, s1.end(), dest.begin() + d);
+    }
+  }
+
+  // lower bound
+  template <template <typename> typename Span, typename T, typename Compare>
+  static std::size_t binary_search(Span<const T> s, const T& v, Compare comp) {
+    std::size_t l = 0;
+    std::size_t h = s.size();
+    while (l < h) {
+      std::size_t m = l + (h - l) / 2;
+      if (!comp(T(s[m]), v)) h = m;
+      else                l = m + 1;
+    }
+    return h;
+  }
+
+  template <template <typename> typename Span, typename T, typename Compare>
+  static void cilkmerge(Span<const T> s1, Span<const T> s2, Span<T> dest,
+                        Compare comp, parallel_sort_options opts) {
+    assert(s1.size() + s2.size() == dest.size());
+
+    if (s1.size() < s2.size()) {
+      // s2 is always smaller
+      std::swap(s1, s2);
+    }
+
+    if (s2.size() == 0) {
+      with_checkout_tied<access_mode::read, access_mode::write>(
+          s1, dest, [&](auto s1_, auto dest_) {
+        std::copy(s1_.begin(), s1_.end(), dest_.begin());
+      });
+      return;
+    }
+
+    if (dest.size() <= opts.cutoff_merge) {
+      with_checkout_tied<access_mode::read, access_mode::read, access_mode::write>(
+          s1, s2, dest, [&](auto s1_, auto s2_, auto dest_) {
+        merge_seq(s1_, s2_, dest_, comp);
+      });
+      return;
+    }
+
+    std::size_t split1 = (s1.size() + 1) / 2;
+    std::size_t split2 = binary_search(s2, T(s1[split1 - 1]), comp);
+
+    auto [s11  , s12  ] = divide(s1, split1);
+    auto [s21  , s22  ] = divide(s2, split2);
+    auto [dest1, dest2] = divide(dest, split1 + split2);
+
+    ito_pattern::parallel_invoke(
+      cilkmerge<Span, T, Compare>, s11, s21, dest1, comp, opts,
+      cilkmerge<Span, T, Compare>, s12, s22, dest2, comp, opts
+    );
+  }
+
+  template <template <typename> typename Span, typename T, typename Compare>
+  static void cilksort(Span<T> a, Span<T> b, Compare comp, parallel_sort_options opts) {
+    assert(a.size() == b.size());
+
+    if (a.size() <= opts.cutoff_quick) {
+      with_checkout_tied<access_mode::read_write>(a, [&](auto a_) {
+        quicksort_seq(a_, comp, opts);
+      });
+      return;
+    }
+
+    auto [a12, a34] = divide_two(a);
+    auto [b12, b34] = divide_two(b);
+
+    auto [a1, a2] = divide_two(a12);
+    auto [a3, a4] = divide_two(a34);
+    auto [b1, b2] = divide_two(b12);
+    auto [b3, b4] = divide_two(b34);
+
+    ito_pattern::parallel_invoke(
+      cilksort<Span, T, Compare>, a1, b1, comp, opts,
+      cilksort<Span, T, Compare>, a2, b2, comp, opts,
+      cilksort<Span, T, Compare>, a3, b3, comp, opts,
+      cilksort<Span, T, Compare>, a4, b4, comp, opts
+    );
+
+    ito_pattern::parallel_invoke(
+      cilkmerge<Span, T, Compare>, Span<const T>(a1), Span<const T>(a2), b12, comp, opts,
+      cilkmerge<Span, T, Compare>, Span<const T>(a3), Span<const T>(a4), b34, comp, opts
+    );
+
+    cilkmerge(Span<const T>(b12), Span<const T>(b34), a, comp, opts);
+  }
+
+public:
+  // Merge two sorted spans s1 and s2 into dest (dest must not overlap with s1 or s2)
+  template <template <typename> typename Span, typename T1, typename T2, typename T,
+            typename Compare = std::less<>>
+  static void parallel_merge(Span<T1>              s1,
+                             Span<T2>              s2,
+                             Span<T>               dest,
+                             Compare               comp = {},
+                             parallel_sort_options opts = {}) {
+    static_assert(std::is_same_v<std::remove_const_t<T1>, T> &&
+                  std::is_same_v<std::remove_const_t<T2>, T>);
+    cilkmerge(Span<const T>(s1), Span<const T>(s2), dest, comp, opts);
+  }
+
+  // Sort s using buf as scratch space (buf.size() must be equal to s.size())
+  template <template <typename> typename Span, typename T,
+            typename Compare = std::less<>>
+  static void parallel_sort(Span<T>               s,
+                            Span<T>               buf,
+                            Compare               comp = {},
+                            parallel_sort_options opts = {}) {
+    static_assert(!std::is_const_v<T>);
+    assert(s.size() == buf.size());
+    cilksort(s, buf, comp, opts);
+  }
+
+  // The scratch buffer is allocated in the local memory of the calling process.
+  // Pass a buffer (e.g., a collective global_vector) to distribute it for large inputs.
+  template <template <typename> typename Span, typename T,
+            typename Compare = std::less<>>
+  static void parallel_sort(Span<T>               s,
+                            Compare               comp = {},
+                            parallel_sort_options opts = {}) {
+    static_assert(!std::is_const_v<T>);
+    if constexpr (std::is_same_v<Span<T>, raw_span<T>>) {
+      std::vector<T> buf(s.size());
+      cilksort(s, Span<T>(buf.begin(), buf.end()), comp, opts);
+    } else {
+      global_vector_options buf_opts {
+        .collective         = false,
+        .parallel_construct = true,
+        .parallel_destruct  = true,
+        .cutoff             = std::max(std::size_t(1), iro::block_size / sizeof(T)),
+      };
+      typename global_container::template global_vector<T> buf(buf_opts, s.size());
+      cilksort(s, Span<T>(buf.begin(), buf.end()), comp, opts);
+    }
+  }
+
+};
+
+struct algorithm_policy_default {
+  using iro = iro_if<iro_policy_default>;
+  using ito_pattern = ito_pattern_if<ito_pattern_policy_default>;
+  using global_container = global_container_if<global_container_policy_default>;
+};
+
+}
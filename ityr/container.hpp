@@ -1,7 +1,16 @@
 #pragma once
 
 #include <cstdlib>
+#include <cstddef>
 #include <cassert>
+#include <tuple>
+#include <utility>
+#include <type_traits>
+#include <array>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <mpi.h>
 
 #include "pcas/pcas.hpp"
 
@@ -79,65 +88,22 @@ inline constexpr auto end(const raw_span<T>& s) noexcept {
   return s.end();
 }
 
-template <pcas::access_mode Mode1,
-          typename T1, typename Fn>
-inline auto with_checkout(const raw_span<T1>& s,
-                          Fn f) {
-  return f(s);
-}
-
-template <pcas::access_mode Mode1,
-          pcas::access_mode Mode2,
-          typename T1, typename T2, typename Fn>
-inline auto with_checkout(const raw_span<T1>& s1,
-                          const raw_span<T2>& s2,
-                          Fn f) {
-  return f(s1, s2);
-}
-
-template <pcas::access_mode Mode1,
-          pcas::access_mode Mode2,
-          pcas::access_mode Mode3,
-          typename T1, typename T2, typename T3, typename Fn>
-inline auto with_checkout(const raw_span<T1>& s1,
-                          const raw_span<T2>& s2,
-                          const raw_span<T3>& s3,
-                          Fn f) {
-  return f(s1, s2, s3);
-}
-
-template <pcas::access_mode Mode1,
-          typename T1, typename Fn>
-inline auto with_checkout_tied(const raw_span<T1>& s,
-                               Fn f) {
-  return f(s);
-}
+template <typename T>
+struct is_raw_span : public std::false_type {};
 
-template <pcas::access_mode Mode1,
-          pcas::access_mode Mode2,
-          typename T1, typename T2, typename Fn>
-inline auto with_checkout_tied(const raw_span<T1>& s1,
-                               const raw_span<T2>& s2,
-                               Fn f) {
-  return f(s1, s2);
-}
+template <typename T>
+struct is_raw_span<raw_span<T>> : public std::true_type {};
 
-template <pcas::access_mode Mode1,
-          pcas::access_mode Mode2,
-          pcas::access_mode Mode3,
-          typename T1, typename T2, typename T3, typename Fn>
-inline auto with_checkout_tied(const raw_span<T1>& s1,
-                               const raw_span<T2>& s2,
-                               const raw_span<T3>& s3,
-                               Fn f) {
-  return f(s1, s2, s3);
-}
+template <typename T>
+inline constexpr bool is_raw_span_v = is_raw_span<T>::value;
 
 struct global_vector_options {
   bool collective = false;
   bool parallel_construct = false;
   bool parallel_destruct = false;
   std::size_t cutoff = 1024;
+  // Home mapping of collective vectors; non-collective vectors are always local
+  distribution dist = {};
 };
 
 template <typename P>
@@ -244,8 +210,11 @@ struct global_container_if {
 
     pointer allocate_mem(size_type count) const {
       if (opts_.collective) {
-        return iro::template malloc<T>(count);
+        assert(opts_.dist.k != distribution::kind::local);
+        return iro::template malloc<T>(count, opts_.dist);
       } else {
+        assert(opts_.dist.k == distribution::kind::policy_default ||
+               opts_.dist.k == distribution::kind::local);
         return iro::template malloc_local<T>(count);
       }
     }
@@ -547,100 +516,378 @@ struct global_container_if {
 
   };
 
+  // Read-only copy of a (small) global array held in node-local shared memory.
+  // Construction, refresh() and destruction are collective over all processes and must be
+  // called outside of tasks, as with barrier().
+  template <typename T>
+  class global_replica {
+    static_assert(std::is_trivially_copyable_v<T>);
+
+  public:
+    using element_type = const T;
+    using value_type   = std::remove_cv_t<T>;
+    using size_type    = std::size_t;
+    using iterator     = const T*;
+
+  private:
+    global_span<const T> src_;
+    std::vector<T>       buf_;
+    MPI_Comm             node_comm_   = MPI_COMM_NULL;
+    MPI_Comm             leader_comm_ = MPI_COMM_NULL;
+    MPI_Win              win_         = MPI_WIN_NULL;
+    T*                   data_        = nullptr;
+
+  public:
+    explicit global_replica(global_span<const T> src) : src_(src) {
+      if (P::n_ranks() == 1) {
+        buf_.resize(src.size());
+        data_ = buf_.data();
+      } else {
+        MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &node_comm_);
+        int node_rank;
+        MPI_Comm_rank(node_comm_, &node_rank);
+        MPI_Comm_split(MPI_COMM_WORLD, node_rank == 0 ? 0 : MPI_UNDEFINED, 0, &leader_comm_);
+
+        MPI_Aint size = node_rank == 0 ? src.size() * sizeof(T) : 0;
+        void* base;
+        MPI_Win_allocate_shared(size, 1, MPI_INFO_NULL, node_comm_, &base, &win_);
+        int disp_unit;
+        MPI_Win_shared_query(win_, 0, &size, &disp_unit, &base);
+        data_ = reinterpret_cast<T*>(base);
+        MPI_Win_lock_all(MPI_MODE_NOCHECK, win_);
+      }
+      refresh();
+    }
+
+    ~global_replica() {
+      if (win_ != MPI_WIN_NULL) {
+        MPI_Win_unlock_all(win_);
+        MPI_Win_free(&win_);
+        MPI_Comm_free(&node_comm_);
+        if (leader_comm_ != MPI_COMM_NULL) {
+          MPI_Comm_free(&leader_comm_);
+        }
+      }
+    }
+
+    global_replica(const global_replica&) = delete;
+    global_replica& operator=(const global_replica&) = delete;
+
+    // Copies the current contents of the source again (collective)
+    void refresh() {
+      if (P::rank() == 0) {
+        iro::get(src_.data(), data_, src_.size());
+      }
+      if (win_ != MPI_WIN_NULL) {
+        if (leader_comm_ != MPI_COMM_NULL) {
+          MPI_Bcast(data_, src_.size() * sizeof(T), MPI_BYTE, 0, leader_comm_);
+        }
+        MPI_Win_sync(win_);
+        MPI_Barrier(node_comm_);
+        MPI_Win_sync(win_);
+      }
+    }
+
+    const T* data() const noexcept { return data_; }
+    size_type size() const noexcept { return src_.size(); }
+
+    iterator begin() const noexcept { return data_; }
+    iterator end() const noexcept { return data_ + size(); }
+
+    const T& operator[](size_type i) const { assert(i < size()); return data_[i]; }
+
+    raw_span<const T> view() const noexcept { return {data_, size()}; }
+  };
+
+  // Size-classed free lists of small global objects, kept per process (i.e., per worker).
+  // Free lists are refilled by carving a slab allocated with a single malloc_local(), so that
+  // allocate() always returns objects homed on the calling process. An object freed on another
+  // process is kept aside until collect_deallocated() returns it to its owner; until then, it
+  // cannot be reused, and its owner may carve new slabs instead.
+  class global_pool {
+    static constexpr std::size_t granularity = 16;
+    static constexpr std::size_t n_classes   = 32;
+    static constexpr std::size_t slab_size   = 64 * 1024;
+
+    struct remote_obj {
+      std::size_t           size_class;
+      global_ptr<std::byte> ptr;
+    };
+    static_assert(std::is_trivially_copyable_v<remote_obj>);
+
+    struct state {
+      std::array<std::vector<global_ptr<std::byte>>, n_classes> free_lists;
+      std::vector<remote_obj>                                   remote_frees;
+      std::vector<global_ptr<std::byte>>                        slabs;
+      // slabs of other processes announced by collect_deallocated() so far
+      std::map<global_ptr<std::byte>, int>                      remote_slabs;
+      std::size_t                                               n_announced_slabs = 0;
+    };
+
+    static state& get_state() {
+      static state s;
+      return s;
+    }
+
+    static std::size_t size_class(std::size_t size) {
+      return (std::max(size, std::size_t(1)) + granularity - 1) / granularity - 1;
+    }
+
+    static void refill(std::size_t c) {
+      auto& st = get_state();
+      std::size_t obj_size = (c + 1) * granularity;
+      auto slab = iro::template malloc_local<std::byte>(slab_size);
+      st.slabs.push_back(slab);
+      for (std::size_t off = 0; off + obj_size <= slab_size; off += obj_size) {
+        st.free_lists[c].push_back(slab + off);
+      }
+    }
+
+    // Tells all processes about the slabs allocated since the last call
+    static void announce_slabs() {
+      auto& st = get_state();
+      int n_ranks = P::n_ranks();
+
+      std::vector<global_ptr<std::byte>> new_slabs(st.slabs.begin() + st.n_announced_slabs, st.slabs.end());
+      st.n_announced_slabs = st.slabs.size();
+
+      int send_count = new_slabs.size() * sizeof(global_ptr<std::byte>);
+      std::vector<int> recv_counts(n_ranks), recv_displs(n_ranks);
+      MPI_Allgather(&send_count, 1, MPI_INT, recv_counts.data(), 1, MPI_INT, MPI_COMM_WORLD);
+
+      int recv_size = 0;
+      for (int i = 0; i < n_ranks; i++) {
+        recv_displs[i] = recv_size;
+        recv_size += recv_counts[i];
+      }
+      std::vector<global_ptr<std::byte>> recv_buf(recv_size / sizeof(global_ptr<std::byte>));
+      MPI_Allgatherv(new_slabs.data(), send_count, MPI_BYTE,
+                     recv_buf.data(), recv_counts.data(), recv_displs.data(), MPI_BYTE, MPI_COMM_WORLD);
+
+      for (int i = 0; i < n_ranks; i++) {
+        if (i == P::rank()) continue;
+        for (int j = recv_displs[i]; j < recv_displs[i] + recv_counts[i]; j += sizeof(global_ptr<std::byte>)) {
+          st.remote_slabs[recv_buf[j / sizeof(global_ptr<std::byte>)]] = i;
+        }
+      }
+    }
+
+    static int slab_owner(global_ptr<std::byte> p) {
+      auto& st = get_state();
+      auto it = st.remote_slabs.upper_bound(p);
+      assert(it != st.remote_slabs.begin());
+      --it;
+      assert(p < it->first + slab_size);
+      return it->second;
+    }
+
+  public:
+    static global_ptr<std::byte> allocate(std::size_t size) {
+      std::size_t c = size_class(size);
+      if (c >= n_classes) {
+        return iro::template malloc_local<std::byte>(size);
+      }
+      auto& fl = get_state().free_lists[c];
+      if (fl.empty()) {
+        refill(c);
+      }
+      auto p = fl.back();
+      fl.pop_back();
+      return p;
+    }
+
+    static void deallocate(global_ptr<std::byte> p, std::size_t size) {
+      std::size_t c = size_class(size);
+      if (c >= n_classes) {
+        iro::free(p, size);
+      } else if (iro::owner(p) == P::rank()) {
+        get_state().free_lists[c].push_back(p);
+      } else {
+        get_state().remote_frees.push_back({c, p});
+      }
+    }
+
+    // Returns the objects freed on other processes to the free lists of their owners.
+    // Collective over all processes and must be called outside of tasks, as with barrier().
+    static void collect_deallocated() {
+      int n_ranks = P::n_ranks();
+      if (n_ranks == 1) return;
+
+      auto& st = get_state();
+      announce_slabs();
+
+      std::vector<std::vector<remote_obj>> objs(n_ranks);
+      for (auto& o : st.remote_frees) {
+        objs[slab_owner(o.ptr)].push_back(o);
+      }
+      st.remote_frees.clear();
+
+      std::vector<int> send_counts(n_ranks), send_displs(n_ranks);
+      std::vector<int> recv_counts(n_ranks), recv_displs(n_ranks);
+      std::vector<remote_obj> send_buf;
+      for (int i = 0; i < n_ranks; i++) {
+        send_displs[i] = send_buf.size() * sizeof(remote_obj);
+        send_counts[i] = objs[i].size() * sizeof(remote_obj);
+        send_buf.insert(send_buf.end(), objs[i].begin(), objs[i].end());
+      }
+      MPI_Alltoall(send_counts.data(), 1, MPI_INT, recv_counts.data(), 1, MPI_INT, MPI_COMM_WORLD);
+
+      int recv_size = 0;
+      for (int i = 0; i < n_ranks; i++) {
+        recv_displs[i] = recv_size;
+        recv_size += recv_counts[i];
+      }
+      std::vector<remote_obj> recv_buf(recv_size / sizeof(remote_obj));
+      MPI_Alltoallv(send_buf.data(), send_counts.data(), send_displs.data(), MPI_BYTE,
+                    recv_buf.data(), recv_counts.data(), recv_displs.data(), MPI_BYTE, MPI_COMM_WORLD);
+
+      for (auto& o : recv_buf) {
+        st.free_lists[o.size_class].push_back(o.ptr);
+      }
+    }
+
+    // Frees all slabs at once. Collective over all processes, which invalidates
+    // all objects allocated from the pool.
+    static void release_all() {
+      auto& st = get_state();
+      for (auto& fl : st.free_lists) {
+        fl.clear();
+      }
+      st.remote_frees.clear();
+      for (auto slab : st.slabs) {
+        iro::free(slab, slab_size);
+      }
+      st.slabs.clear();
+      st.remote_slabs.clear();
+      st.n_announced_slabs = 0;
+    }
+  };
+
+  template <typename T>
+  struct pool {
+    static global_ptr<T> allocate(std::size_t n = 1) {
+      return global_ptr<T>(global_pool::allocate(n * sizeof(T)));
+    }
+
+    static void deallocate(global_ptr<T> p, std::size_t n = 1) {
+      global_pool::deallocate(global_ptr<std::byte>(p), n * sizeof(T));
+    }
+  };
+
+  // Bump allocator whose objects are all freed at once by release(), e.g., for a whole tree.
+  // Each process allocates from its own chunks. Arenas must be created in the same order on
+  // all processes (outside of tasks) and release() is collective; copies refer to the same arena.
+  class global_arena {
+    static constexpr std::size_t chunk_size = 64 * 1024;
+
+    struct state {
+      std::vector<std::pair<global_ptr<std::byte>, std::size_t>> chunks;
+      std::size_t                                                used = chunk_size;
+    };
+
+    static std::unordered_map<int, state>& get_states() {
+      static std::unordered_map<int, state> states;
+      return states;
+    }
+
+    static int& next_id() {
+      static int id = 0;
+      return id;
+    }
+
+    int id_;
+
+  public:
+    global_arena() : id_(next_id()++) {}
+
+    global_ptr<std::byte> allocate(std::size_t size, std::size_t align = alignof(std::max_align_t)) {
+      auto& st = get_states()[id_];
+      if (size > chunk_size / 4) {
+        auto p = iro::template malloc_local<std::byte>(size);
+        st.chunks.emplace_back(p, size);
+        return p;
+      }
+      std::size_t off = (st.used + align - 1) / align * align;
+      if (st.chunks.empty() || st.chunks.back().second != chunk_size || off + size > chunk_size) {
+        st.chunks.emplace_back(iro::template malloc_local<std::byte>(chunk_size), chunk_size);
+        off = 0;
+      }
+      st.used = off + size;
+      return st.chunks.back().first + off;
+    }
+
+    template <typename T>
+    global_ptr<T> allocate(std::size_t n = 1) {
+      return global_ptr<T>(allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void release() {
+      auto& states = get_states();
+      auto it = states.find(id_);
+      if (it != states.end()) {
+        for (auto [p, size] : it->second.chunks) {
+          iro::free(p, size);
+        }
+        states.erase(it);
+      }
+    }
+  };
+
 };
 
-// TODO: we would like to move these with_checkout calls to the inner class
-// and make them friend, but we cannot do it because functions with explicit
-// template parameters (Modes in our case) are not candidates for ADL in C++17.
-// (this issue is resolved in C++20).
-template <pcas::access_mode Mode,
-          typename GlobalSpan, typename Fn>
-inline auto with_checkout(GlobalSpan s, Fn f) {
-  using T = typename GlobalSpan::element_type;
-  using iro_context = typename GlobalSpan::policy::iro_context;
-  return iro_context::template with_checkout<Mode>(s.data(), s.size(),
-                                                   [&](auto&& p) {
-    return f(raw_span<T>{p, s.size()});
-  });
-}
+template <bool Tied, pcas::access_mode... Modes, typename ArgsTuple, std::size_t... Is>
+inline auto with_checkout_spans(ArgsTuple&& args, std::index_sequence<Is...>) {
+  static_assert(sizeof...(Is) == sizeof...(Modes), "Arguments must be (span1, ..., spanN, f)");
 
-template <pcas::access_mode Mode1,
-          pcas::access_mode Mode2,
-          typename GlobalSpan1, typename GlobalSpan2, typename Fn>
-inline auto with_checkout(GlobalSpan1 s1, GlobalSpan2 s2, Fn f) {
-  using T1 = typename GlobalSpan1::element_type;
-  using T2 = typename GlobalSpan2::element_type;
-  using iro_context = typename GlobalSpan1::policy::iro_context;
-  return iro_context::template with_checkout<Mode1, Mode2>(s1.data(), s1.size(),
-                                                           s2.data(), s2.size(),
-                                                           [&](auto&& p1, auto&& p2) {
-    return f(raw_span<T1>{p1, s1.size()}, raw_span<T2>{p2, s2.size()});
-  });
-}
+  using args_t = std::remove_reference_t<ArgsTuple>;
+  auto&& f = std::get<sizeof...(Is)>(args);
 
-template <pcas::access_mode Mode1,
-          pcas::access_mode Mode2,
-          pcas::access_mode Mode3,
-          typename GlobalSpan1, typename GlobalSpan2, typename GlobalSpan3, typename Fn>
-inline auto with_checkout(GlobalSpan1 s1, GlobalSpan2 s2, GlobalSpan3 s3, Fn f) {
-  using T1 = typename GlobalSpan1::element_type;
-  using T2 = typename GlobalSpan2::element_type;
-  using T3 = typename GlobalSpan3::element_type;
-  using iro_context = typename GlobalSpan1::policy::iro_context;
-  return iro_context::template with_checkout<Mode1, Mode2, Mode3>(s1.data(), s1.size(),
-                                                                  s2.data(), s2.size(),
-                                                                  s3.data(), s3.size(),
-                                                                  [&](auto&& p1, auto&& p2, auto&& p3) {
-    return f(raw_span<T1>{p1, s1.size()}, raw_span<T2>{p2, s2.size()}, raw_span<T3>{p3, s3.size()});
-  });
-}
+  if constexpr ((is_raw_span_v<std::decay_t<std::tuple_element_t<Is, args_t>>> && ...)) {
+    return f(std::get<Is>(args)...);
+
+  } else {
+    using iro_context = typename std::decay_t<std::tuple_element_t<0, args_t>>::policy::iro_context;
+
+    auto f_raw = [&](auto&&... ps) {
+      return f(raw_span<std::remove_pointer_t<std::decay_t<decltype(ps)>>>{ps, std::get<Is>(args).size()}...);
+    };
 
-template <pcas::access_mode Mode,
-          typename GlobalSpan, typename Fn>
-inline auto with_checkout_tied(GlobalSpan s, Fn f) {
-  using T = typename GlobalSpan::element_type;
-  using iro_context = typename GlobalSpan::policy::iro_context;
-  return iro_context::template with_checkout_tied<Mode>(s.data(), s.size(),
-                                                        [&](auto&& p) {
-    return f(raw_span<T>{p, s.size()});
-  });
+    auto ptr_args = std::tuple_cat(std::make_tuple(std::get<Is>(args).data(), std::get<Is>(args).size())...);
+    return std::apply([&](auto&&... ptr_args_) {
+      if constexpr (Tied) {
+        return iro_context::template with_checkout_tied<Modes...>(ptr_args_..., f_raw);
+      } else {
+        return iro_context::template with_checkout<Modes...>(ptr_args_..., f_raw);
+      }
+    }, ptr_args);
+  }
 }
 
-template <pcas::access_mode Mode1,
-          pcas::access_mode Mode2,
-          typename GlobalSpan1, typename GlobalSpan2, typename Fn>
-inline auto with_checkout_tied(GlobalSpan1 s1, GlobalSpan2 s2, Fn f) {
-  using T1 = typename GlobalSpan1::element_type;
-  using T2 = typename GlobalSpan2::element_type;
-  using iro_context = typename GlobalSpan1::policy::iro_context;
-  return iro_context::template with_checkout_tied<Mode1, Mode2>(s1.data(), s1.size(),
-                                                                s2.data(), s2.size(),
-                                                                [&](auto&& p1, auto&& p2) {
-    return f(raw_span<T1>{p1, s1.size()}, raw_span<T2>{p2, s2.size()});
-  });
+// with_checkout<Mode1, ..., ModeN>(s1, ..., sN, f) calls f with raw spans of s1, ..., sN.
+// Spans must be either all raw_span or all global_span.
+//
+// TODO: we would like to move these with_checkout calls to the inner class
+// and make them friend, but we cannot do it because functions with explicit
+// template parameters (Modes in our case) are not candidates for ADL in C++17.
+// (this issue is resolved in C++20).
+template <pcas::access_mode... Modes, typename... Args>
+inline auto with_checkout(Args&&... args) {
+  return with_checkout_spans<false, Modes...>(std::forward_as_tuple(std::forward<Args>(args)...),
+                                              std::make_index_sequence<sizeof...(Args) - 1>{});
 }
 
-template <pcas::access_mode Mode1,
-          pcas::access_mode Mode2,
-          pcas::access_mode Mode3,
-          typename GlobalSpan1, typename GlobalSpan2, typename GlobalSpan3, typename Fn>
-inline auto with_checkout_tied(GlobalSpan1 s1, GlobalSpan2 s2, GlobalSpan3 s3, Fn f) {
-  using T1 = typename GlobalSpan1::element_type;
-  using T2 = typename GlobalSpan2::element_type;
-  using T3 = typename GlobalSpan3::element_type;
-  using iro_context = typename GlobalSpan1::policy::iro_context;
-  return iro_context::template with_checkout_tied<Mode1, Mode2, Mode3>(s1.data(), s1.size(),
-                                                                       s2.data(), s2.size(),
-                                                                       s3.data(), s3.size(),
-                                                                       [&](auto&& p1, auto&& p2, auto&& p3) {
-    return f(raw_span<T1>{p1, s1.size()}, raw_span<T2>{p2, s2.size()}, raw_span<T3>{p3, s3.size()});
-  });
+template <pcas::access_mode... Modes, typename... Args>
+inline auto with_checkout_tied(Args&&... args) {
+  return with_checkout_spans<true, Modes...>(std::forward_as_tuple(std::forward<Args>(args)...),
+                                             std::make_index_sequence<sizeof...(Args) - 1>{});
 }
 
 struct global_container_policy_default {
   using iro = iro_if<iro_policy_default>;
   using iro_context = iro_context_if<iro_context_policy_default>;
   using ito_pattern = ito_pattern_if<ito_pattern_policy_default>;
+  static int rank() { return 0; }
+  static int n_ranks() { return 1; }
 };
 
 }
@@ -1,6 +1,21 @@
 #pragma once
 
 #include <cassert>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+#include <utility>
+#include <mpi.h>
 
 #include "pcas/pcas.hpp"
 
@@ -10,6 +25,47 @@
 
 namespace ityr {
 
+struct locality_stats {
+  std::size_t n_checkouts       = 0;
+  std::size_t n_local_checkouts = 0;
+};
+
+// Home mapping of a global allocation. block and cyclic distribute it over all processes;
+// the segment size of cyclic is in bytes (a multiple of the block size; 0 means the block
+// size). local places it in the memory of the calling process, like malloc_local().
+// custom takes a factory of pcas mem_mappers. The default follows ITYR_DIST_POLICY.
+struct distribution {
+  enum class kind { policy_default, block, cyclic, local, custom };
+  using mapper_factory = std::unique_ptr<pcas::mem_mapper::base> (*)(std::size_t size, int nproc);
+
+  kind           k            = kind::policy_default;
+  std::size_t    segment_size = 0;
+  mapper_factory factory      = nullptr;
+
+  static constexpr distribution block() { return {kind::block, 0, nullptr}; }
+  static constexpr distribution cyclic(std::size_t segment_size = 0) { return {kind::cyclic, segment_size, nullptr}; }
+  static constexpr distribution local() { return {kind::local, 0, nullptr}; }
+  static constexpr distribution custom(mapper_factory f) { return {kind::custom, 0, f}; }
+};
+
+// Adapts a distribution::mapper_factory to the mem_mapper template interface of pcas
+template <std::size_t BlockSize>
+class mem_mapper_custom : public pcas::mem_mapper::base {
+  std::unique_ptr<pcas::mem_mapper::base> impl_;
+
+public:
+  mem_mapper_custom(std::size_t size, int nproc, distribution::mapper_factory f)
+    : base(size, nproc), impl_(f(size, nproc)) {}
+
+  std::size_t get_local_size(int owner) const override {
+    return impl_->get_local_size(owner);
+  }
+
+  pcas::mem_mapper::segment get_segment(std::size_t offset) const override {
+    return impl_->get_segment(offset);
+  }
+};
+
 template <typename P>
 class iro_if {
   using impl_t = typename P::template iro_impl_t<P>;
@@ -24,9 +80,18 @@ class iro_if {
     return *get_optional_instance();
   }
 
+  template <typename... Ms, std::size_t... Is>
+  static auto load_fields(const std::byte*                              base,
+                          const std::array<std::ptrdiff_t, sizeof...(Ms)>& offsets,
+                          std::index_sequence<Is...>) {
+    return std::tuple<std::remove_const_t<Ms>...>{*reinterpret_cast<const Ms*>(base + offsets[Is])...};
+  }
+
 public:
   template <typename T>
   using global_ptr = typename impl_t::template global_ptr<T>;
+  template <typename T>
+  using global_atomic_ptr = typename impl_t::template global_atomic_ptr<T>;
   using access_mode = typename impl_t::access_mode;
   using release_handler = typename impl_t::release_handler;
 
@@ -66,6 +131,18 @@ public:
     }
   }
 
+  // Exempts [ptr, ptr + nelems) from cache invalidation at acquire fences until thaw(ptr, nelems).
+  // The region must not be modified by any process while it is frozen.
+  template <typename T>
+  static void freeze(global_ptr<T> ptr, std::size_t nelems) {
+    get_instance().freeze(ptr, nelems);
+  }
+
+  template <typename T>
+  static void thaw(global_ptr<T> ptr, std::size_t nelems) {
+    get_instance().thaw(ptr, nelems);
+  }
+
   static void poll() {
     get_instance().poll();
   }
@@ -74,9 +151,10 @@ public:
     get_instance().collect_deallocated();
   }
 
+  // Collective unless dist is distribution::local()
   template <typename T>
-  static global_ptr<T> malloc(std::size_t nelems) {
-    return get_instance().template malloc<T>(nelems);
+  static global_ptr<T> malloc(std::size_t nelems, const distribution& dist = {}) {
+    return get_instance().template malloc<T>(nelems, dist);
   }
 
   template <typename T>
@@ -99,11 +177,74 @@ public:
     get_instance().put(from_ptr, to_ptr, nelems);
   }
 
+  template <typename ConstT, typename T>
+  static void get_nocache(global_ptr<ConstT> from_ptr, T* to_ptr, std::size_t nelems) {
+    get_instance().get_nocache(from_ptr, to_ptr, nelems);
+  }
+
+  template <typename T>
+  static void put_nocache(const T* from_ptr, global_ptr<T> to_ptr, std::size_t nelems) {
+    get_instance().put_nocache(from_ptr, to_ptr, nelems);
+  }
+
   template <typename T>
   static void willread(global_ptr<T> ptr, std::size_t nelems) {
     get_instance().willread(ptr, nelems);
   }
 
+  // Rank whose memory is the home of *ptr, or -1 if unknown
+  template <typename T>
+  static int owner(global_ptr<T> ptr) {
+    return get_instance().owner(ptr);
+  }
+
+  // Global atomic words. They live in an MPI window owned by ityr instead of global memory,
+  // so that each operation is a single MPI atomic on the home word that bypasses the cache
+  // (one round trip if the word is remote). malloc_atomic() takes a word of the calling
+  // process, and the word can be freed by any process.
+  template <typename T>
+  static global_atomic_ptr<T> malloc_atomic(T init) {
+    static_assert(std::is_arithmetic_v<T> && sizeof(T) <= sizeof(uint64_t));
+    return get_instance().malloc_atomic(init);
+  }
+
+  template <typename T>
+  static void free_atomic(global_atomic_ptr<T> ptr) {
+    get_instance().free_atomic(ptr);
+  }
+
+  template <typename T>
+  static T load(global_atomic_ptr<T> ptr) {
+    return get_instance().load(ptr);
+  }
+
+  template <typename T>
+  static T fetch_add(global_atomic_ptr<T> ptr, T val) {
+    return get_instance().fetch_add(ptr, val);
+  }
+
+  template <typename T>
+  static T fetch_min(global_atomic_ptr<T> ptr, T val) {
+    return get_instance().fetch_min(ptr, val);
+  }
+
+  template <typename T>
+  static T fetch_max(global_atomic_ptr<T> ptr, T val) {
+    return get_instance().fetch_max(ptr, val);
+  }
+
+  template <typename T>
+  static T exchange(global_atomic_ptr<T> ptr, T val) {
+    return get_instance().exchange(ptr, val);
+  }
+
+  // Returns the previous value; the swap happened iff it is equal to expected.
+  // Floating-point values are compared bitwise.
+  template <typename T>
+  static T compare_exchange(global_atomic_ptr<T> ptr, T expected, T desired) {
+    return get_instance().compare_exchange(ptr, expected, desired);
+  }
+
   template <access_mode Mode, typename T>
   static auto checkout(global_ptr<T> ptr, std::size_t nelems) {
     return get_instance().template checkout<Mode>(ptr, nelems);
@@ -115,6 +256,140 @@ public:
     whitelist_add(raw_ptr, sizeof(T) * nelems);
   }
 
+  // Reads the given members of *ptr with a single checkout of the bytes spanning them
+  // and returns their values as a tuple, e.g., fetch_fields(p, &T::a, &T::b)
+  template <typename T, typename... Ms, typename... Cs>
+  static auto fetch_fields(global_ptr<T> ptr, Ms Cs::*... mps) {
+    static_assert(sizeof...(mps) > 0);
+    using U = std::remove_const_t<T>;
+    using byte_gptr = global_ptr<const std::byte>;
+
+    std::array<std::ptrdiff_t, sizeof...(mps)> offsets {
+      (byte_gptr(&(ptr->*(static_cast<Ms U::*>(mps)))) - byte_gptr(ptr))...};
+    std::array<std::size_t, sizeof...(mps)> sizes {sizeof(Ms)...};
+
+    std::ptrdiff_t off_b = offsets[0];
+    std::ptrdiff_t off_e = offsets[0] + sizes[0];
+    for (std::size_t i = 1; i < offsets.size(); i++) {
+      off_b = std::min(off_b, offsets[i]);
+      off_e = std::max(off_e, std::ptrdiff_t(offsets[i] + sizes[i]));
+    }
+
+    const std::byte* raw_ptr = checkout<access_mode::read>(byte_gptr(ptr) + off_b, off_e - off_b);
+    auto ret = load_fields<Ms...>(raw_ptr - off_b, offsets, std::index_sequence_for<Ms...>{});
+    checkin<access_mode::read>(raw_ptr, off_e - off_b);
+    return ret;
+  }
+
+  // Accumulate-mode checkout: returns a local buffer of nelems copies of identity. The checkout
+  // itself fetches nothing; values written to the buffer are combined into the global region
+  // with op at checkin_accumulate().
+  template <typename T>
+  static T* checkout_accumulate(global_ptr<T>, std::size_t nelems, const T& identity = T{}) {
+    auto raw_ptr = std::allocator<T>{}.allocate(nelems);
+    std::uninitialized_fill_n(raw_ptr, nelems, identity);
+    return raw_ptr;
+  }
+
+  // Not an MPI accumulate: the blocks covering the region are locked (see global_lock_table),
+  // the home copy is read into a temporary buffer with get_nocache, each element g is replaced
+  // with op(g, local), and the result is written back with put_nocache before unlocking.
+  // A checkin thus costs a lock and an unlock round trip per covered block, a get and a put
+  // of the whole region, and a heap allocation of nelems elements. In exchange, concurrent
+  // accumulations to the same elements are not lost, including user reductions on class types.
+  template <typename T, typename BinaryOp = std::plus<>>
+  static void checkin_accumulate(T* raw_ptr, global_ptr<T> ptr, std::size_t nelems, BinaryOp op = {}) {
+    get_instance().accumulate(raw_ptr, ptr, nelems, op);
+    std::destroy_n(raw_ptr, nelems);
+    std::allocator<T>{}.deallocate(raw_ptr, nelems);
+  }
+
+  template <typename T, typename Fn, typename BinaryOp = std::plus<>>
+  static void with_accumulate(global_ptr<T> ptr, std::size_t nelems, Fn&& f,
+                              BinaryOp op = {}, const T& identity = T{}) {
+    T* raw_ptr = checkout_accumulate(ptr, nelems, identity);
+    std::forward<Fn>(f)(raw_ptr);
+    checkin_accumulate(raw_ptr, ptr, nelems, op);
+  }
+
+  // Handle of a checkout started by checkout_async().
+  // wait() completes the checkout and returns the raw pointer; checkin() must be called after wait()
+  // before the handle is destroyed. A handle that is never waited for needs no checkin.
+  template <access_mode Mode, typename T>
+  class checkout_handle {
+    global_ptr<T>                                                ptr_;
+    std::size_t                                                  nelems_;
+    std::conditional_t<Mode == access_mode::read, const T*, T*> raw_ptr_ = nullptr;
+
+  public:
+    checkout_handle(global_ptr<T> ptr, std::size_t nelems) : ptr_(ptr), nelems_(nelems) {
+      if constexpr (Mode != access_mode::write) {
+        willread(ptr_, nelems_);
+      }
+    }
+
+    checkout_handle(const checkout_handle&) = delete;
+    checkout_handle& operator=(const checkout_handle&) = delete;
+
+    checkout_handle(checkout_handle&& h)
+      : ptr_(h.ptr_), nelems_(h.nelems_), raw_ptr_(std::exchange(h.raw_ptr_, nullptr)) {}
+
+    ~checkout_handle() { assert(!raw_ptr_); }
+
+    auto wait() {
+      if (!raw_ptr_) {
+        raw_ptr_ = checkout<Mode>(ptr_, nelems_);
+      }
+      return raw_ptr_;
+    }
+
+    void checkin() {
+      assert(raw_ptr_);
+      iro_if::checkin<Mode>(raw_ptr_, nelems_);
+      raw_ptr_ = nullptr;
+    }
+  };
+
+  // Starts fetching the region and returns immediately, so that computation on other data can
+  // overlap the communication. The raw pointer is obtained by wait() on the returned handle.
+  template <access_mode Mode, typename T>
+  static checkout_handle<Mode, T> checkout_async(global_ptr<T> ptr, std::size_t nelems) {
+    return checkout_handle<Mode, T>(ptr, nelems);
+  }
+
+  template <typename T>
+  using checkout_region = std::pair<global_ptr<T>, std::size_t>;
+
+  template <access_mode Mode, typename T>
+  using raw_ptr_t = std::conditional_t<Mode == access_mode::read, const T*, T*>;
+
+  // Checks out all the given (ptr, nelems) regions and returns their raw pointers in the same order.
+  // Fetches of all regions are issued before waiting for any of them, so that
+  // scattered small objects (e.g., tree nodes) do not pay a round trip each.
+  template <access_mode Mode, typename T>
+  static std::vector<raw_ptr_t<Mode, T>> checkout_batch(const std::vector<checkout_region<T>>& regions) {
+    if constexpr (Mode != access_mode::write) {
+      for (const auto& [ptr, nelems] : regions) {
+        willread(ptr, nelems);
+      }
+    }
+    std::vector<raw_ptr_t<Mode, T>> raw_ptrs;
+    raw_ptrs.reserve(regions.size());
+    for (const auto& [ptr, nelems] : regions) {
+      raw_ptrs.push_back(checkout<Mode>(ptr, nelems));
+    }
+    return raw_ptrs;
+  }
+
+  template <access_mode Mode, typename T>
+  static void checkin_batch(const std::vector<raw_ptr_t<Mode, T>>& raw_ptrs,
+                            const std::vector<checkout_region<T>>& regions) {
+    assert(raw_ptrs.size() == regions.size());
+    for (std::size_t i = 0; i < regions.size(); i++) {
+      checkin<Mode>(raw_ptrs[i], regions[i].second);
+    }
+  }
+
   static void whitelist_add(const void* raw_ptr, std::size_t size) {
     if constexpr (P::enable_acquire_whitelist) {
       get_instance().whitelist_add(raw_ptr, size);
@@ -143,6 +418,15 @@ public:
     }
   }
 
+  // Counts of checkouts, and of those served directly from this rank's own local allocations
+  static locality_stats get_locality_stats() {
+    return get_instance().get_locality_stats();
+  }
+
+  static void reset_locality_stats() {
+    get_instance().reset_locality_stats();
+  }
+
   static void logger_clear() {
     get_instance().logger_clear();
   }
@@ -157,6 +441,250 @@ public:
 
 };
 
+// Stack allocator for the buffers of checkouts, which are mostly checked in in LIFO order.
+// A buffer freed out of order is reclaimed when all the buffers allocated after it are freed.
+class checkout_buffer_arena {
+  static constexpr std::size_t chunk_size = std::size_t(1) << 20;
+  static constexpr std::size_t align      = alignof(std::max_align_t);
+
+  struct chunk {
+    std::unique_ptr<std::byte[]> buf;
+    std::size_t                  size;
+  };
+
+  struct entry {
+    std::size_t chunk_idx;
+    std::size_t offset;
+    std::size_t end;
+    bool        freed;
+  };
+
+  std::vector<chunk> chunks_;
+  std::vector<entry> entries_;
+
+public:
+  void* allocate(std::size_t size) {
+    std::size_t c   = entries_.empty() ? 0 : entries_.back().chunk_idx;
+    std::size_t off = entries_.empty() ? 0 : (entries_.back().end + align - 1) / align * align;
+
+    if (c >= chunks_.size() || off + size > chunks_[c].size) {
+      // the current chunk holds live entries (possibly of size 0), so move on to the next one
+      if (!entries_.empty()) {
+        c++;
+      }
+      off = 0;
+      // chunks after the current one are unused, so a too small one can be replaced
+      if (c < chunks_.size() && chunks_[c].size < size) {
+        chunks_.erase(chunks_.begin() + c, chunks_.end());
+      }
+      if (c >= chunks_.size()) {
+        std::size_t chunk_sz = std::max(size, chunk_size);
+        chunks_.push_back({std::make_unique<std::byte[]>(chunk_sz), chunk_sz});
+      }
+    }
+
+    entries_.push_back({c, off, off + size, false});
+    return chunks_[c].buf.get() + off;
+  }
+
+  void deallocate(const void* p) {
+    auto it = std::find_if(entries_.rbegin(), entries_.rend(), [&](const entry& e) {
+      return !e.freed && chunks_[e.chunk_idx].buf.get() + e.offset == p;
+    });
+    assert(it != entries_.rend());
+    it->freed = true;
+    while (!entries_.empty() && entries_.back().freed) {
+      entries_.pop_back();
+    }
+  }
+};
+
+// Spin locks in an MPI window that serialize read-modify-write operations on global memory.
+// pcas does not expose the windows of its home memory, so an accumulate checkin locks the
+// blocks holding the target, reads and writes its home copy with get_nocache/put_nocache
+// (which complete before returning), and then unlocks them. Locks are indexed by block so
+// that all processes agree on the lock of an address, and are always taken in ascending order.
+class global_lock_table {
+  static constexpr std::size_t n_locks_per_rank = 1024;
+
+  int       rank_;
+  int       nproc_;
+  MPI_Win   win_;
+  uint64_t* locks_;
+
+public:
+  // (rank, index in the window of the rank)
+  using lock_id = std::pair<int, std::size_t>;
+
+  explicit global_lock_table(MPI_Comm comm) {
+    MPI_Comm_rank(comm, &rank_);
+    MPI_Comm_size(comm, &nproc_);
+    MPI_Win_allocate(n_locks_per_rank * sizeof(uint64_t), sizeof(uint64_t),
+                     MPI_INFO_NULL, comm, &locks_, &win_);
+    std::fill_n(locks_, n_locks_per_rank, 0);
+    MPI_Win_lock_all(MPI_MODE_NOCHECK, win_);
+    MPI_Barrier(comm);
+  }
+
+  ~global_lock_table() {
+    MPI_Win_unlock_all(win_);
+    MPI_Win_free(&win_);
+  }
+
+  global_lock_table(const global_lock_table&) = delete;
+  global_lock_table& operator=(const global_lock_table&) = delete;
+
+  // Locks all the blocks overlapping [addr, addr + size) and returns their lock ids
+  std::vector<lock_id> lock_range(std::uintptr_t addr, std::size_t size, std::size_t block_size) {
+    std::vector<lock_id> ids;
+    for (std::size_t b = addr / block_size; b <= (addr + std::max(size, std::size_t(1)) - 1) / block_size; b++) {
+      ids.emplace_back(int(b % nproc_), (b / nproc_) % n_locks_per_rank);
+    }
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+    for (const auto& id : ids) {
+      lock(id);
+    }
+    return ids;
+  }
+
+  void unlock_range(const std::vector<lock_id>& ids) {
+    for (const auto& id : ids) {
+      unlock(id);
+    }
+  }
+
+private:
+  void lock(const lock_id& id) {
+    const uint64_t free_v = 0;
+    const uint64_t mine_v = rank_ + 1;
+    uint64_t prev;
+    do {
+      MPI_Compare_and_swap(&mine_v, &free_v, &prev, MPI_UINT64_T, id.first, id.second, win_);
+      MPI_Win_flush(id.first, win_);
+    } while (prev != free_v);
+  }
+
+  void unlock(const lock_id& id) {
+    const uint64_t free_v = 0;
+    uint64_t prev;
+    MPI_Fetch_and_op(&free_v, &prev, MPI_UINT64_T, id.first, id.second, MPI_REPLACE, win_);
+    MPI_Win_flush(id.first, win_);
+    assert(prev == uint64_t(rank_ + 1));
+  }
+};
+
+// Reference to a word of a global_atomic_table: the rank holding it and its index there
+template <typename T>
+struct global_atomic_ptr {
+  int         rank = -1;
+  std::size_t idx  = 0;
+};
+
+template <typename T>
+inline MPI_Datatype mpi_atomic_datatype() {
+  if constexpr (std::is_same_v<T, float>) {
+    return MPI_FLOAT;
+  } else if constexpr (std::is_same_v<T, double>) {
+    return MPI_DOUBLE;
+  } else if constexpr (std::is_signed_v<T>) {
+    if constexpr (sizeof(T) == 1) return MPI_INT8_T;
+    else if constexpr (sizeof(T) == 2) return MPI_INT16_T;
+    else if constexpr (sizeof(T) == 4) return MPI_INT32_T;
+    else return MPI_INT64_T;
+  } else {
+    if constexpr (sizeof(T) == 1) return MPI_UINT8_T;
+    else if constexpr (sizeof(T) == 2) return MPI_UINT16_T;
+    else if constexpr (sizeof(T) == 4) return MPI_UINT32_T;
+    else return MPI_UINT64_T;
+  }
+}
+
+// Words in an MPI window owned by ityr, on which the global atomic operations are issued as
+// MPI_Fetch_and_op or MPI_Compare_and_swap followed by a flush. The window of each rank holds
+// n_words value words followed by their allocation flags. A rank allocates words only from
+// its own window, by swapping a flag from 0 to 1, and any rank can free a word.
+class global_atomic_table {
+  static constexpr std::size_t n_words = 4096;
+
+  int         rank_;
+  MPI_Win     win_;
+  uint64_t*   words_;
+  std::size_t next_ = 0;
+
+public:
+  explicit global_atomic_table(MPI_Comm comm) {
+    MPI_Comm_rank(comm, &rank_);
+    MPI_Win_allocate(2 * n_words * sizeof(uint64_t), sizeof(uint64_t),
+                     MPI_INFO_NULL, comm, &words_, &win_);
+    std::fill_n(words_, 2 * n_words, 0);
+    MPI_Win_lock_all(MPI_MODE_NOCHECK, win_);
+    MPI_Barrier(comm);
+  }
+
+  ~global_atomic_table() {
+    MPI_Win_unlock_all(win_);
+    MPI_Win_free(&win_);
+  }
+
+  global_atomic_table(const global_atomic_table&) = delete;
+  global_atomic_table& operator=(const global_atomic_table&) = delete;
+
+  template <typename T>
+  global_atomic_ptr<T> allocate(T init) {
+    for (std::size_t k = 0; k < n_words; k++) {
+      std::size_t i = (next_ + k) % n_words;
+      if (compare_and_swap(rank_, n_words + i, uint64_t(0), uint64_t(1)) == 0) {
+        next_ = i + 1;
+        fetch_and_op(rank_, i, init, MPI_REPLACE);
+        return {rank_, i};
+      }
+    }
+    throw std::bad_alloc();
+  }
+
+  template <typename T>
+  void deallocate(global_atomic_ptr<T> ptr) {
+    fetch_and_op(ptr.rank, n_words + ptr.idx, uint64_t(0), MPI_REPLACE);
+  }
+
+  template <typename T>
+  T fetch_and_op(global_atomic_ptr<T> ptr, T val, MPI_Op op) {
+    return fetch_and_op(ptr.rank, ptr.idx, val, op);
+  }
+
+  template <typename T>
+  T compare_and_swap(global_atomic_ptr<T> ptr, T expected, T desired) {
+    return compare_and_swap(ptr.rank, ptr.idx, expected, desired);
+  }
+
+private:
+  template <typename T>
+  T fetch_and_op(int rank, std::size_t disp, T val, MPI_Op op) {
+    T prev;
+    MPI_Fetch_and_op(&val, &prev, mpi_atomic_datatype<T>(), rank, disp, op, win_);
+    MPI_Win_flush(rank, win_);
+    return prev;
+  }
+
+  // MPI_Compare_and_swap does not take floating-point types, so values are swapped as
+  // unsigned integers of the same size
+  template <typename T>
+  T compare_and_swap(int rank, std::size_t disp, T expected, T desired) {
+    using word_t = std::conditional_t<sizeof(T) == 1, uint8_t,
+                   std::conditional_t<sizeof(T) == 2, uint16_t,
+                   std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>>>;
+    word_t e, d, prev;
+    std::memcpy(&e, &expected, sizeof(T));
+    std::memcpy(&d, &desired, sizeof(T));
+    MPI_Compare_and_swap(&d, &e, &prev, mpi_atomic_datatype<word_t>(), rank, disp, win_);
+    MPI_Win_flush(rank, win_);
+    T ret;
+    std::memcpy(&ret, &prev, sizeof(T));
+    return ret;
+  }
+};
+
 template <typename P>
 struct my_pcas_policy : public pcas::policy_default {
   template <typename GPtrT>
@@ -203,14 +731,275 @@ class iro_pcas_default : public pcas::pcas_if<my_pcas_policy<P>> {
 
   std::vector<pcas::whitelist> wls_;
 
+  // [begin, end) of the regions allocated by malloc_local() of this rank, only for regions of
+  // at least local_region_min_size bytes (e.g., pool slabs and arena chunks). Tracking every
+  // small object would cost a map insertion per allocation and make lookups slower, while
+  // small objects gain little from bypassing the cache.
+  static constexpr std::size_t local_region_min_size = 4096;
+  std::map<std::uintptr_t, std::uintptr_t> local_regions_;
+
+  // begin -> end and home mapping of the regions allocated by malloc() (collective)
+  struct dist_region {
+    std::uintptr_t                            end;
+    std::shared_ptr<pcas::mem_mapper::base> mapper;
+  };
+  std::map<std::uintptr_t, dist_region> dist_regions_;
+
+  locality_stats lstats_;
+
+  // address -> size of the regions exempted from invalidation by freeze()
+  std::map<std::uintptr_t, std::size_t> frozen_regions_;
+  pcas::whitelist frozen_wl_;
+
+  global_lock_table locks_{MPI_COMM_WORLD};
+  global_atomic_table atomics_{MPI_COMM_WORLD};
+
 public:
   template <typename T>
   using global_ptr = typename base_t::template global_ptr<T>;
+  template <typename T>
+  using global_atomic_ptr = ityr::global_atomic_ptr<T>;
   using access_mode = pcas::access_mode;
   using release_handler = pcas::release_handler;
 
   using base_t::base_t;
 
+  // Whether [ptr, ptr + nelems) is in this rank's own local allocation. Such regions are
+  // mapped at their global addresses and never cached, so they can be accessed directly.
+  template <typename T>
+  bool is_local(global_ptr<T> ptr, std::size_t nelems) const {
+    return is_local_raw(ptr.raw_ptr(), nelems);
+  }
+
+  // is_local() for checkouts, counted in the locality stats
+  template <typename T>
+  bool is_local_checkout(global_ptr<T> ptr, std::size_t nelems) {
+    bool local = is_local(ptr, nelems);
+    lstats_.n_checkouts++;
+    lstats_.n_local_checkouts += local;
+    return local;
+  }
+
+  // The same test on the raw pointer of a checkout, so that a checkin takes the same path
+  // as its checkout (the direct pointer, or the cache/buffer of the base class)
+  template <typename T>
+  bool is_local_raw(const T* raw_ptr, std::size_t nelems) const {
+    if (local_regions_.empty()) return false;
+    auto addr = reinterpret_cast<std::uintptr_t>(raw_ptr);
+    auto it = local_regions_.upper_bound(addr);
+    return it != local_regions_.begin() && addr + nelems * sizeof(T) <= std::prev(it)->second;
+  }
+
+  template <typename T>
+  int owner(global_ptr<T> ptr) const {
+    if (is_local(ptr, 1)) return base_t::rank();
+    auto addr = reinterpret_cast<std::uintptr_t>(ptr.raw_ptr());
+    auto it = dist_regions_.upper_bound(addr);
+    if (it == dist_regions_.begin() || addr >= std::prev(it)->second.end) return -1;
+    --it;
+    return it->second.mapper->get_segment(addr - it->first).owner;
+  }
+
+  template <typename T, template <std::size_t> typename MemMapper, typename... MemMapperArgs>
+  global_ptr<T> malloc_mapped(std::size_t nelems, MemMapperArgs... mmargs) {
+    auto ptr = base_t::template malloc<T, MemMapper>(nelems, mmargs...);
+    auto addr = reinterpret_cast<std::uintptr_t>(ptr.raw_ptr());
+    dist_regions_[addr] = {addr + nelems * sizeof(T),
+                           std::make_shared<MemMapper<base_t::block_size>>(nelems * sizeof(T), base_t::nproc(), mmargs...)};
+    return ptr;
+  }
+
+  template <typename T>
+  global_ptr<T> malloc(std::size_t nelems, const distribution& dist) {
+    switch (dist.k) {
+      case distribution::kind::block:
+        return malloc_mapped<T, pcas::mem_mapper::block>(nelems);
+      case distribution::kind::cyclic:
+        return malloc_mapped<T, pcas::mem_mapper::cyclic>(
+            nelems, dist.segment_size ? dist.segment_size : base_t::block_size);
+      case distribution::kind::local:
+        return malloc_local<T>(nelems);
+      case distribution::kind::custom:
+        assert(dist.factory);
+        return malloc_mapped<T, mem_mapper_custom>(nelems, dist.factory);
+      default:
+        return malloc_mapped<T, my_pcas_policy<P>::template default_mem_mapper>(nelems);
+    }
+  }
+
+  template <typename T>
+  global_ptr<T> malloc_local(std::size_t nelems) {
+    auto ptr = base_t::template malloc_local<T>(nelems);
+    if (nelems * sizeof(T) >= local_region_min_size) {
+      auto addr = reinterpret_cast<std::uintptr_t>(ptr.raw_ptr());
+      auto end  = addr + nelems * sizeof(T);
+      // regions freed by other ranks are not erased from the map, so entries overlapping
+      // the new region are stale and are removed here
+      auto it = local_regions_.upper_bound(addr);
+      if (it != local_regions_.begin() && std::prev(it)->second > addr) --it;
+      while (it != local_regions_.end() && it->first < end) {
+        it = local_regions_.erase(it);
+      }
+      local_regions_[addr] = end;
+    }
+    return ptr;
+  }
+
+  template <typename T>
+  void free(global_ptr<T> ptr, std::size_t nelems) {
+    local_regions_.erase(reinterpret_cast<std::uintptr_t>(ptr.raw_ptr()));
+    dist_regions_.erase(reinterpret_cast<std::uintptr_t>(ptr.raw_ptr()));
+    base_t::free(ptr, nelems);
+  }
+
+  template <typename ConstT, typename T>
+  void get(global_ptr<ConstT> from_ptr, T* to_ptr, std::size_t nelems) {
+    if (is_local(from_ptr, nelems)) {
+      std::memcpy(static_cast<void*>(to_ptr), from_ptr.raw_ptr(), nelems * sizeof(T));
+    } else {
+      base_t::get(from_ptr, to_ptr, nelems);
+    }
+  }
+
+  template <typename T>
+  void put(const T* from_ptr, global_ptr<T> to_ptr, std::size_t nelems) {
+    if (is_local(to_ptr, nelems)) {
+      std::memcpy(static_cast<void*>(to_ptr.raw_ptr()), from_ptr, nelems * sizeof(T));
+    } else {
+      base_t::put(from_ptr, to_ptr, nelems);
+    }
+  }
+
+  template <typename ConstT, typename T>
+  void get_nocache(global_ptr<ConstT> from_ptr, T* to_ptr, std::size_t nelems) {
+    if (is_local(from_ptr, nelems)) {
+      std::memcpy(static_cast<void*>(to_ptr), from_ptr.raw_ptr(), nelems * sizeof(T));
+    } else {
+      base_t::get_nocache(from_ptr, to_ptr, nelems);
+    }
+  }
+
+  template <typename T>
+  void put_nocache(const T* from_ptr, global_ptr<T> to_ptr, std::size_t nelems) {
+    if (is_local(to_ptr, nelems)) {
+      std::memcpy(static_cast<void*>(to_ptr.raw_ptr()), from_ptr, nelems * sizeof(T));
+    } else {
+      base_t::put_nocache(from_ptr, to_ptr, nelems);
+    }
+  }
+
+  template <typename T, typename BinaryOp>
+  void accumulate(const T* from_ptr, global_ptr<T> to_ptr, std::size_t nelems, BinaryOp op) {
+    auto ids = locks_.lock_range(reinterpret_cast<std::uintptr_t>(to_ptr.raw_ptr()),
+                                 nelems * sizeof(T), base_t::block_size);
+    std::vector<T> buf(from_ptr, from_ptr + nelems);
+    get_nocache(to_ptr, buf.data(), nelems);
+    for (std::size_t i = 0; i < nelems; i++) {
+      buf[i] = op(buf[i], from_ptr[i]);
+    }
+    put_nocache(buf.data(), to_ptr, nelems);
+    locks_.unlock_range(ids);
+  }
+
+  template <typename T>
+  global_atomic_ptr<T> malloc_atomic(T init) {
+    return atomics_.allocate(init);
+  }
+
+  template <typename T>
+  void free_atomic(global_atomic_ptr<T> ptr) {
+    atomics_.deallocate(ptr);
+  }
+
+  template <typename T>
+  T load(global_atomic_ptr<T> ptr) {
+    return atomics_.fetch_and_op(ptr, T{}, MPI_NO_OP);
+  }
+
+  template <typename T>
+  T fetch_add(global_atomic_ptr<T> ptr, T val) {
+    return atomics_.fetch_and_op(ptr, val, MPI_SUM);
+  }
+
+  template <typename T>
+  T fetch_min(global_atomic_ptr<T> ptr, T val) {
+    return atomics_.fetch_and_op(ptr, val, MPI_MIN);
+  }
+
+  template <typename T>
+  T fetch_max(global_atomic_ptr<T> ptr, T val) {
+    return atomics_.fetch_and_op(ptr, val, MPI_MAX);
+  }
+
+  template <typename T>
+  T exchange(global_atomic_ptr<T> ptr, T val) {
+    return atomics_.fetch_and_op(ptr, val, MPI_REPLACE);
+  }
+
+  template <typename T>
+  T compare_exchange(global_atomic_ptr<T> ptr, T expected, T desired) {
+    return atomics_.compare_and_swap(ptr, expected, desired);
+  }
+
+  template <access_mode Mode, typename T>
+  std::conditional_t<Mode == access_mode::read, const T*, T*>
+  checkout(global_ptr<T> ptr, std::size_t nelems) {
+    if (is_local_checkout(ptr, nelems)) {
+      return ptr.raw_ptr();
+    }
+    return base_t::template checkout<Mode>(ptr, nelems);
+  }
+
+  template <access_mode Mode, typename T>
+  void checkin(T* raw_ptr, std::size_t nelems) {
+    if (!is_local_raw(raw_ptr, nelems)) {
+      base_t::template checkin<Mode>(raw_ptr, nelems);
+    }
+  }
+
+  locality_stats get_locality_stats() const { return lstats_; }
+  void reset_locality_stats() { lstats_ = {}; }
+
+  void acquire() {
+    if (frozen_regions_.empty()) {
+      base_t::acquire();
+    } else {
+      base_t::acquire(frozen_wl_);
+    }
+  }
+
+  void acquire(release_handler handler) {
+    base_t::acquire(handler);
+  }
+
+  void acquire(const pcas::whitelist& wl) {
+    base_t::acquire(wl);
+  }
+
+  template <typename T>
+  void freeze(global_ptr<T> ptr, std::size_t nelems) {
+    auto addr = reinterpret_cast<std::uintptr_t>(ptr.raw_ptr());
+    frozen_regions_[addr] = nelems * sizeof(T);
+    frozen_wl_.add(ptr.raw_ptr(), nelems * sizeof(T));
+    for (auto& wl : wls_) {
+      wl.add(ptr.raw_ptr(), nelems * sizeof(T));
+    }
+  }
+
+  template <typename T>
+  void thaw(global_ptr<T> ptr, std::size_t) {
+    frozen_regions_.erase(reinterpret_cast<std::uintptr_t>(ptr.raw_ptr()));
+    // Whitelists can only grow, so reset them to the remaining frozen regions.
+    // Dropping the other entries only makes the next acquire more conservative.
+    frozen_wl_ = {};
+    for (auto [addr, size] : frozen_regions_) {
+      frozen_wl_.add(reinterpret_cast<const void*>(addr), size);
+    }
+    for (auto& wl : wls_) {
+      wl = frozen_wl_;
+    }
+  }
+
   void whitelist_add(const void* raw_ptr, std::size_t size) {
     wls_.back().add(raw_ptr, size);
   }
@@ -220,7 +1009,7 @@ public:
   }
 
   void whitelist_new() {
-    wls_.emplace_back();
+    wls_.push_back(frozen_wl_);
   }
 
   void whitelist_merge() {
@@ -231,7 +1020,7 @@ public:
 
   void whitelist_clear() {
     wls_.clear();
-    wls_.emplace_back();
+    wls_.push_back(frozen_wl_);
   }
 
   void logger_clear() {
@@ -251,6 +1040,8 @@ template <typename P>
 class iro_pcas_nocache : public iro_pcas_default<P> {
   using base_t = iro_pcas_default<P>;
 
+  checkout_buffer_arena buf_arena_;
+
 public:
   template <typename T>
   using global_ptr = typename base_t::template global_ptr<T>;
@@ -285,9 +1076,13 @@ public:
     static_assert(!std::is_const_v<T> || Mode == access_mode::read,
                   "Const pointers cannot be checked out with write access mode");
 
+    if (this->is_local_checkout(ptr, nelems)) {
+      return ptr.raw_ptr();
+    }
+
     using gptr_t = global_ptr<std::conditional_t<std::is_const_v<T>, const std::byte, std::byte>>;
     std::size_t size = nelems * sizeof(T);
-    auto ret = (std::remove_const_t<T>*)std::malloc(size + sizeof(gptr_t));
+    auto ret = (std::remove_const_t<T>*)buf_arena_.allocate(size + sizeof(gptr_t));
     if (Mode != access_mode::write) {
       get(ptr, ret, nelems);
     }
@@ -296,18 +1091,21 @@ public:
   }
 
   template <access_mode Mode, typename T>
-  void checkin(const T* raw_ptr, std::size_t) {
-    std::free(const_cast<T*>(raw_ptr));
+  void checkin(const T* raw_ptr, std::size_t nelems) {
+    if (this->is_local_raw(raw_ptr, nelems)) return;
+    buf_arena_.deallocate(raw_ptr);
   }
 
   template <access_mode Mode, typename T>
   void checkin(T* raw_ptr, std::size_t nelems) {
+    if (this->is_local_raw(raw_ptr, nelems)) return;
+
     using gptr_t = global_ptr<std::byte>;
 
     std::size_t size = nelems * sizeof(T);
     auto ptr = *reinterpret_cast<gptr_t*>(reinterpret_cast<std::byte*>(raw_ptr) + size);
     put(reinterpret_cast<std::byte*>(raw_ptr), ptr, size);
-    std::free(raw_ptr);
+    buf_arena_.deallocate(raw_ptr);
   }
 };
 
@@ -315,6 +1113,8 @@ template <typename P>
 class iro_pcas_getput : public iro_pcas_default<P> {
   using base_t = iro_pcas_default<P>;
 
+  checkout_buffer_arena buf_arena_;
+
 public:
   template <typename T>
   using global_ptr = typename base_t::template global_ptr<T>;
@@ -331,9 +1131,13 @@ public:
     static_assert(!std::is_const_v<T> || Mode == access_mode::read,
                   "Const pointers cannot be checked out with write access mode");
 
+    if (this->is_local_checkout(ptr, nelems)) {
+      return ptr.raw_ptr();
+    }
+
     using gptr_t = global_ptr<std::conditional_t<std::is_const_v<T>, const std::byte, std::byte>>;
     std::size_t size = nelems * sizeof(T);
-    auto ret = (std::remove_const_t<T>*)std::malloc(size + sizeof(gptr_t));
+    auto ret = (std::remove_const_t<T>*)buf_arena_.allocate(size + sizeof(gptr_t));
     if (Mode != access_mode::write) {
       get(ptr, ret, nelems);
     }
@@ -342,18 +1146,21 @@ public:
   }
 
   template <access_mode Mode, typename T>
-  void checkin(const T* raw_ptr, std::size_t) {
-    std::free(const_cast<T*>(raw_ptr));
+  void checkin(const T* raw_ptr, std::size_t nelems) {
+    if (this->is_local_raw(raw_ptr, nelems)) return;
+    buf_arena_.deallocate(raw_ptr);
   }
 
   template <access_mode Mode, typename T>
   void checkin(T* raw_ptr, std::size_t nelems) {
+    if (this->is_local_raw(raw_ptr, nelems)) return;
+
     using gptr_t = global_ptr<std::byte>;
 
     std::size_t size = nelems * sizeof(T);
     auto ptr = *reinterpret_cast<gptr_t*>(reinterpret_cast<std::byte*>(raw_ptr) + size);
     put(reinterpret_cast<std::byte*>(raw_ptr), ptr, size);
-    std::free(raw_ptr);
+    buf_arena_.deallocate(raw_ptr);
   }
 };
 
@@ -362,6 +1169,8 @@ class iro_dummy {
 public:
   template <typename T>
   using global_ptr = T*;
+  template <typename T>
+  using global_atomic_ptr = T*;
   using access_mode = pcas::access_mode;
   using release_handler = int;
 
@@ -377,7 +1186,9 @@ public:
   void collect_deallocated() {}
 
   template <typename T>
-  global_ptr<T> malloc(std::size_t nelems) { return reinterpret_cast<T*>(std::malloc(nelems * sizeof(T))); }
+  global_ptr<T> malloc(std::size_t nelems, const distribution& = {}) {
+    return reinterpret_cast<T*>(std::malloc(nelems * sizeof(T)));
+  }
   template <typename T>
   global_ptr<T> malloc_local(std::size_t nelems) { return malloc<T>(nelems); }
   template <typename T>
@@ -385,17 +1196,53 @@ public:
 
   template <typename ConstT, typename T>
   void get(global_ptr<ConstT> from_ptr, T* to_ptr, std::size_t nelems) {
-    std::memcpy(to_ptr, from_ptr, nelems * sizeof(T));
+    std::memcpy(static_cast<void*>(to_ptr), from_ptr, nelems * sizeof(T));
   }
   template <typename T>
   void put(const T* from_ptr, global_ptr<T> to_ptr, std::size_t nelems) {
-    std::memcpy(to_ptr, from_ptr, nelems * sizeof(T));
+    std::memcpy(static_cast<void*>(to_ptr), from_ptr, nelems * sizeof(T));
+  }
+  template <typename ConstT, typename T>
+  void get_nocache(global_ptr<ConstT> from_ptr, T* to_ptr, std::size_t nelems) {
+    std::memcpy(static_cast<void*>(to_ptr), from_ptr, nelems * sizeof(T));
+  }
+  template <typename T>
+  void put_nocache(const T* from_ptr, global_ptr<T> to_ptr, std::size_t nelems) {
+    std::memcpy(static_cast<void*>(to_ptr), from_ptr, nelems * sizeof(T));
   }
 
   template <typename T>
   void willread(global_ptr<T> ptr, std::size_t nelems) {}
+  template <typename T>
+  int owner(global_ptr<T>) const { return 0; }
   template <access_mode Mode, typename T>
   auto checkout(global_ptr<T> ptr, std::size_t nelems) { return ptr; }
+
+  template <typename T, typename BinaryOp>
+  void accumulate(const T* from_ptr, global_ptr<T> to_ptr, std::size_t nelems, BinaryOp op) {
+    for (std::size_t i = 0; i < nelems; i++) to_ptr[i] = op(to_ptr[i], from_ptr[i]);
+  }
+
+  template <typename T>
+  global_atomic_ptr<T> malloc_atomic(T init) { return new T(init); }
+  template <typename T>
+  void free_atomic(global_atomic_ptr<T> ptr) { delete ptr; }
+  template <typename T>
+  T load(global_atomic_ptr<T> ptr) { return *ptr; }
+  template <typename T>
+  T fetch_add(global_atomic_ptr<T> ptr, T val) { T ret = *ptr; *ptr += val; return ret; }
+  template <typename T>
+  T fetch_min(global_atomic_ptr<T> ptr, T val) { T ret = *ptr; *ptr = std::min(ret, val); return ret; }
+  template <typename T>
+  T fetch_max(global_atomic_ptr<T> ptr, T val) { T ret = *ptr; *ptr = std::max(ret, val); return ret; }
+  template <typename T>
+  T exchange(global_atomic_ptr<T> ptr, T val) { T ret = *ptr; *ptr = val; return ret; }
+  template <typename T>
+  T compare_exchange(global_atomic_ptr<T> ptr, T expected, T desired) {
+    T ret = *ptr;
+    if (std::memcmp(&ret, &expected, sizeof(T)) == 0) *ptr = desired;
+    return ret;
+  }
   template <access_mode Mode, typename T>
   void checkin(T* raw_ptr, std::size_t nelems) {}
 
@@ -403,6 +1250,14 @@ public:
   void logger_flush(uint64_t t_begin, uint64_t t_end) {}
   void logger_flush_and_print_stat(uint64_t t_begin, uint64_t t_end) {}
 
+  template <typename T>
+  void freeze(global_ptr<T>, std::size_t) {}
+  template <typename T>
+  void thaw(global_ptr<T>, std::size_t) {}
+
+  locality_stats get_locality_stats() const { return {}; }
+  void reset_locality_stats() {}
+
   void whitelist_add(const void*, std::size_t) {}
   void whitelist_new() {}
   void whitelist_merge() {}
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <tuple>
+#include <utility>
+
 #include "pcas/pcas.hpp"
 
 #include "ityr/util.hpp"
@@ -15,76 +18,61 @@ class iro_context_if {
   template <typename T>
   using global_ptr = typename iro::template global_ptr<T>;
 
-public:
-  template <access_mode Mode, typename T, typename Fn>
-  static auto with_checkout(global_ptr<T> p, std::size_t n, Fn&& f) {
-    return impl::template with_checkout<Mode>(p, n, std::forward<Fn>(f));
-  }
-
-  template <access_mode Mode1, access_mode Mode2,
-            typename T1, typename T2, typename Fn>
-  static auto with_checkout(global_ptr<T1> p1, std::size_t n1,
-                            global_ptr<T2> p2, std::size_t n2,
-                            Fn&& f) {
-    return with_checkout<Mode1>(p1, n1, [&](auto&& p1_) {
-      return with_checkout<Mode2>(p2, n2, [&](auto&& p2_) {
-        return std::forward<Fn>(f)(std::forward<decltype(p1_)>(p1_),
-                                   std::forward<decltype(p2_)>(p2_));
-      });
-    });
+  template <access_mode Mode, access_mode... Modes, typename T, typename... Rest>
+  static void willread_all(global_ptr<T> p, std::size_t n, Rest&&... rest) {
+    if constexpr (Mode != access_mode::write) {
+      iro::willread(p, n);
+    }
+    if constexpr (sizeof...(Modes) > 0) {
+      willread_all<Modes...>(std::forward<Rest>(rest)...);
+    }
   }
 
-  template <access_mode Mode1, access_mode Mode2, access_mode Mode3,
-            typename T1, typename T2, typename T3, typename Fn>
-  static auto with_checkout(global_ptr<T1> p1, std::size_t n1,
-                            global_ptr<T2> p2, std::size_t n2,
-                            global_ptr<T3> p3, std::size_t n3,
-                            Fn&& f) {
-    return with_checkout<Mode1>(p1, n1, [&](auto&& p1_) {
-      return with_checkout<Mode2>(p2, n2, [&](auto&& p2_) {
-        return with_checkout<Mode3>(p3, n3, [&](auto&& p3_) {
-          return std::forward<Fn>(f)(std::forward<decltype(p1_)>(p1_),
-                                     std::forward<decltype(p2_)>(p2_),
-                                     std::forward<decltype(p3_)>(p3_));
-        });
-      });
-    });
+  template <bool Tied, access_mode Mode, access_mode... Modes,
+            typename Fn, typename T, typename... Rest>
+  static auto with_checkout_nested(Fn&& f, global_ptr<T> p, std::size_t n, Rest&&... rest) {
+    auto g = [&](auto&& p_) {
+      if constexpr (sizeof...(Modes) == 0) {
+        return std::forward<Fn>(f)(std::forward<decltype(p_)>(p_));
+      } else {
+        return with_checkout_nested<Tied, Modes...>([&](auto&&... ps_) {
+          return std::forward<Fn>(f)(std::forward<decltype(p_)>(p_),
+                                     std::forward<decltype(ps_)>(ps_)...);
+        }, std::forward<Rest>(rest)...);
+      }
+    };
+    if constexpr (Tied) {
+      return impl::template with_checkout_tied<Mode>(p, n, g);
+    } else {
+      return impl::template with_checkout<Mode>(p, n, g);
+    }
   }
 
-  // It must be guaranteed that the thread is not migrated to another worker during execution of f
-  template <access_mode Mode, typename T, typename Fn>
-  static auto with_checkout_tied(global_ptr<T> p, std::size_t n, Fn&& f) {
-    return impl::template with_checkout_tied<Mode>(p, n, std::forward<Fn>(f));
+  template <bool Tied, access_mode... Modes, typename ArgsTuple, std::size_t... Is>
+  static auto with_checkout_impl(ArgsTuple&& args, std::index_sequence<Is...>) {
+    static_assert(sizeof...(Is) == 2 * sizeof...(Modes),
+                  "Arguments must be (ptr1, n1, ptr2, n2, ..., f)");
+    if constexpr (sizeof...(Modes) > 1) {
+      // issue reads of all regions first so that their latencies overlap
+      willread_all<Modes...>(std::get<Is>(args)...);
+    }
+    return with_checkout_nested<Tied, Modes...>(std::get<sizeof...(Is)>(std::move(args)),
+                                                std::get<Is>(args)...);
   }
 
-  template <access_mode Mode1, access_mode Mode2,
-            typename T1, typename T2, typename Fn>
-  static auto with_checkout_tied(global_ptr<T1> p1, std::size_t n1,
-                                 global_ptr<T2> p2, std::size_t n2,
-                                 Fn&& f) {
-    return with_checkout_tied<Mode1>(p1, n1, [&](auto&& p1_) {
-      return with_checkout_tied<Mode2>(p2, n2, [&](auto&& p2_) {
-        return std::forward<Fn>(f)(std::forward<decltype(p1_)>(p1_),
-                                   std::forward<decltype(p2_)>(p2_));
-      });
-    });
+public:
+  // with_checkout<Mode1, ..., ModeN>(p1, n1, ..., pN, nN, f) calls f(raw_p1, ..., raw_pN)
+  template <access_mode... Modes, typename... Args>
+  static auto with_checkout(Args&&... args) {
+    return with_checkout_impl<false, Modes...>(std::forward_as_tuple(std::forward<Args>(args)...),
+                                               std::make_index_sequence<sizeof...(Args) - 1>{});
   }
 
-  template <access_mode Mode1, access_mode Mode2, access_mode Mode3,
-            typename T1, typename T2, typename T3, typename Fn>
-  static auto with_checkout_tied(global_ptr<T1> p1, std::size_t n1,
-                                 global_ptr<T2> p2, std::size_t n2,
-                                 global_ptr<T3> p3, std::size_t n3,
-                                 Fn&& f) {
-    return with_checkout_tied<Mode1>(p1, n1, [&](auto&& p1_) {
-      return with_checkout_tied<Mode2>(p2, n2, [&](auto&& p2_) {
-        return with_checkout_tied<Mode3>(p3, n3, [&](auto&& p3_) {
-          return std::forward<Fn>(f)(std::forward<decltype(p1_)>(p1_),
-                                     std::forward<decltype(p2_)>(p2_),
-                                     std::forward<decltype(p3_)>(p3_));
-        });
-      });
-    });
+  // It must be guaranteed that the thread is not migrated to another worker during execution of f
+  template <access_mode... Modes, typename... Args>
+  static auto with_checkout_tied(Args&&... args) {
+    return with_checkout_impl<true, Modes...>(std::forward_as_tuple(std::forward<Args>(args)...),
+                                              std::make_index_sequence<sizeof...(Args) - 1>{});
   }
 
   template <typename Fn, typename... Args>
@@ -101,26 +89,30 @@ class iro_context_enabled {
   template <typename T>
   using global_ptr = typename iro::template global_ptr<T>;
 
+  // Entries are linked through the stack frames of with_checkout(), which stay at the same
+  // addresses across thread migration, so that no copy or heap allocation is needed.
   struct checkout_entry {
-    uintptr_t addr;
-    std::size_t size;
-    access_mode mode;
+    uintptr_t       addr;
+    std::size_t     size;
+    access_mode     mode;
+    checkout_entry* prev;
   };
 
-  static std::vector<checkout_entry>& checkout_entries() {
-    static std::vector<checkout_entry> entries;
-    return entries;
+  // The innermost checkout entry of the running thread on this worker
+  static checkout_entry*& current_entry() {
+    static checkout_entry* ce = nullptr;
+    return ce;
   }
 
 public:
   template <access_mode Mode, typename T, typename Fn>
   static auto with_checkout(global_ptr<T> p, std::size_t n, Fn&& f) {
     auto p_ = iro::template checkout<Mode>(p, n);
-    auto& local_ces = checkout_entries();
-    local_ces.push_back({reinterpret_cast<uintptr_t>(p_), n * sizeof(T), Mode});
+    checkout_entry ce {reinterpret_cast<uintptr_t>(p_), n * sizeof(T), Mode, current_entry()};
+    current_entry() = &ce;
 
     auto at_end = [&]() {
-      local_ces.pop_back();
+      current_entry() = ce.prev;
       iro::template checkin<Mode>(p_, n);
     };
 
@@ -150,46 +142,36 @@ public:
 
   template <typename Fn, typename... Args>
   static auto with_checkout_cancel(Fn&& f, Args&&... args) {
-    auto& local_ces = checkout_entries();
-    if (!local_ces.empty()) {
-      // FIXME: configurable maximum checkout entry num or flexible size
-      constexpr int max_checkout_entries = 10;
-      checkout_entry ces[max_checkout_entries];
-
-      int count = 0;
-      for (const auto& ce : local_ces) {
-        if (ce.mode == access_mode::read) {
-          iro::template checkin<access_mode::read>(reinterpret_cast<const std::byte*>(ce.addr), ce.size);
+    checkout_entry* saved_ce = current_entry();
+    if (saved_ce) {
+      for (auto ce = saved_ce; ce; ce = ce->prev) {
+        if (ce->mode == access_mode::read) {
+          iro::template checkin<access_mode::read>(reinterpret_cast<const std::byte*>(ce->addr), ce->size);
         } else {
           // assume that checkin behaves the same for read_write and read
-          iro::template checkin<access_mode::write>(reinterpret_cast<std::byte*>(ce.addr), ce.size);
+          iro::template checkin<access_mode::write>(reinterpret_cast<std::byte*>(ce->addr), ce->size);
         }
-
-        // save checkout entries in the stack region
-        ces[count++] = ce;
-        assert(count <= max_checkout_entries);
       }
 
-      local_ces.clear();
+      // the function (and the tasks it spawns) starts with no checkout entry
+      current_entry() = nullptr;
 
-      // called after the given function is finished
+      // called after the given function is finished, possibly on another worker
       auto at_end = [&]() {
-        for (int i = 0; i < count; i++) {
-          const auto& ce = ces[i];
-
-          auto gptr = global_ptr<std::byte>(reinterpret_cast<std::byte*>(ce.addr));
+        for (auto ce = saved_ce; ce; ce = ce->prev) {
+          auto gptr = global_ptr<std::byte>(reinterpret_cast<std::byte*>(ce->addr));
 
-          if (ce.mode == access_mode::read) {
-            iro::template checkout<access_mode::read>(gptr, ce.size);
+          if (ce->mode == access_mode::read) {
+            iro::template checkout<access_mode::read>(gptr, ce->size);
           } else {
             // Change the access mode from write to read_write so that
             // the changes by the previous thread are visible to successors
-            iro::template checkout<access_mode::read_write>(gptr, ce.size);
+            iro::template checkout<access_mode::read_write>(gptr, ce->size);
           }
-
-          // restore checkout entries
-          local_ces.push_back(ce);
         }
+
+        // restore checkout entries
+        current_entry() = saved_ce;
       };
 
       if constexpr (std::is_void_v<std::invoke_result_t<Fn, Args...>>) {
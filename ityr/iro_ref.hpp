@@ -1,5 +1,8 @@
 #pragma once
 
+#include <type_traits>
+#include <utility>
+
 #include "pcas/pcas.hpp"
 
 namespace ityr {
@@ -21,6 +24,19 @@ class iro_ref : public pcas::global_ref_base<GPtrT> {
     iro::template checkin<iro::access_mode::read_write>(vp, 1);
   }
 
+  // Overwrites the whole element without fetching it first. Objects that are not
+  // trivially copyable may depend on their old state on assignment, so they are read.
+  template <typename V>
+  void store(V&& v) {
+    if constexpr (std::is_trivially_copyable_v<value_t>) {
+      value_t* vp = iro::template checkout<iro::access_mode::write>(ptr_, 1);
+      *vp = std::forward<V>(v);
+      iro::template checkin<iro::access_mode::write>(vp, 1);
+    } else {
+      with_read_write([&](value_t& this_v) { this_v = std::forward<V>(v); });
+    }
+  }
+
 public:
   using base_t::base_t;
 
@@ -34,12 +50,12 @@ public:
   }
 
   this_t& operator=(const value_t& v) {
-    with_read_write([&](value_t& this_v) { this_v = v; });
+    store(v);
     return *this;
   }
 
   this_t& operator=(value_t&& v) {
-    with_read_write([&](value_t& this_v) { this_v = std::move(v); });
+    store(std::move(v));
     return *this;
   }
 
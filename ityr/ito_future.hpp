@@ -0,0 +1,266 @@
+#pragma once
+
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+#include "uth.h"
+
+#include "ityr/iro.hpp"
+
+namespace ityr {
+
+// A handle to a task spawned by async(), which may outlive the spawning function.
+// get() joins the task; when_all() joins several tasks with a single fence.
+template <typename P, typename T>
+class ito_future_if {
+  using impl_t = typename P::template ito_future_impl_t<P, T>;
+
+  std::optional<impl_t> impl_;
+
+  template <typename P_, typename... Ts>
+  friend auto when_all(ito_future_if<P_, Ts>&... fs);
+
+public:
+  using value_type = T;
+
+  ito_future_if() {}
+
+  template <typename Fn, typename... Args>
+  explicit ito_future_if(std::in_place_t, Fn&& f, Args&&... args) {
+    impl_.emplace(std::forward<Fn>(f), std::forward<Args>(args)...);
+  }
+
+  ito_future_if(const ito_future_if&) = delete;
+  ito_future_if& operator=(const ito_future_if&) = delete;
+
+  ito_future_if(ito_future_if&& f) : impl_(std::move(f.impl_)) { f.impl_.reset(); }
+  ito_future_if& operator=(ito_future_if&& f) {
+    assert(!valid());
+    impl_ = std::move(f.impl_);
+    f.impl_.reset();
+    return *this;
+  }
+
+  ~ito_future_if() { assert(!valid()); }
+
+  bool valid() const { return impl_.has_value(); }
+
+  T get() {
+    assert(valid());
+    typename impl_t::join_state s;
+    impl_t::join_begin(s);
+    if constexpr (std::is_void_v<T>) {
+      impl_->join(s);
+      impl_t::join_end(s);
+      impl_.reset();
+    } else {
+      T ret = impl_->join(s);
+      impl_t::join_end(s);
+      impl_.reset();
+      return ret;
+    }
+  }
+};
+
+// Results of void futures are represented as std::monostate
+template <typename P, typename... Ts>
+inline auto when_all(ito_future_if<P, Ts>&... fs) {
+  if constexpr (sizeof...(Ts) == 0) {
+    return std::make_tuple();
+  } else {
+    using impl_t = typename P::template ito_future_impl_t<P, void>;
+    typename impl_t::join_state s;
+    impl_t::join_begin(s);
+    auto join_one = [&](auto& f) {
+      assert(f.valid());
+      if constexpr (std::is_void_v<typename std::remove_reference_t<decltype(f)>::value_type>) {
+        f.impl_->join(s);
+        f.impl_.reset();
+        return std::monostate{};
+      } else {
+        auto ret = f.impl_->join(s);
+        f.impl_.reset();
+        return ret;
+      }
+    };
+    // braced initialization joins the tasks in order
+    std::tuple<std::conditional_t<std::is_void_v<Ts>, std::monostate, Ts>...> ret{join_one(fs)...};
+    impl_t::join_end(s);
+    return ret;
+  }
+}
+
+// Join states are shared by futures of different types joined in a single when_all()
+struct ito_future_join_state_dummy {};
+
+struct ito_future_join_state_workfirst {
+  bool blocked = false;
+  bool needs_acquire = false;
+};
+
+template <typename P, typename T>
+class ito_future_serial {
+  std::conditional_t<std::is_void_v<T>, std::monostate, T> ret_;
+
+  template <typename Fn, typename... Args>
+  static auto invoke(Fn&& f, Args&&... args) {
+    if constexpr (std::is_void_v<T>) {
+      std::forward<Fn>(f)(std::forward<Args>(args)...);
+      return std::monostate{};
+    } else {
+      return std::forward<Fn>(f)(std::forward<Args>(args)...);
+    }
+  }
+
+public:
+  using join_state = ito_future_join_state_dummy;
+
+  template <typename Fn, typename... Args>
+  explicit ito_future_serial(Fn&& f, Args&&... args)
+    : ret_(invoke(std::forward<Fn>(f), std::forward<Args>(args)...)) {}
+
+  static void join_begin(join_state&) {}
+  static void join_end(join_state&) {}
+
+  T join(join_state&) {
+    if constexpr (!std::is_void_v<T>) {
+      return std::move(ret_);
+    }
+  }
+};
+
+template <typename P, typename T>
+class ito_future_naive {
+  using iro = typename P::iro;
+
+  madm::uth::thread<T> th_;
+
+public:
+  using join_state = ito_future_join_state_dummy;
+
+  template <typename Fn, typename... Args>
+  explicit ito_future_naive(Fn&& f, Args&&... args) {
+    iro::release();
+    new (&th_) madm::uth::thread<T>{[f = std::forward<Fn>(f),
+                                     args = std::make_tuple(std::forward<Args>(args)...)]() mutable {
+      iro::acquire();
+      if constexpr (std::is_void_v<T>) {
+        std::apply(std::move(f), std::move(args));
+        iro::release();
+      } else {
+        T r = std::apply(std::move(f), std::move(args));
+        iro::release();
+        return r;
+      }
+    }};
+    iro::acquire();
+  }
+
+  static void join_begin(join_state&) { iro::release(); }
+  static void join_end(join_state&) { iro::acquire(); }
+
+  T join(join_state&) { return th_.join(); }
+};
+
+template <typename P, typename T>
+class ito_future_workfirst {
+  using iro = typename P::iro;
+
+protected:
+  madm::uth::thread<T> th_;
+  bool synched_;
+  int initial_rank_;
+
+  struct lazy_release {};
+
+  template <typename Fn, typename... Args>
+  ito_future_workfirst(lazy_release, Fn&& f, Args&&... args) {
+    iro::poll();
+
+    typename iro::release_handler rh;
+    iro::release_lazy(&rh);
+
+    initial_rank_ = P::rank();
+    spawn(std::forward<Fn>(f), std::forward<Args>(args)...);
+    if (!synched_) {
+      iro::acquire(rh);
+    }
+
+    iro::poll();
+  }
+
+  template <typename Fn, typename... Args>
+  void spawn(Fn&& f, Args&&... args) {
+    new (&th_) madm::uth::thread<T>{};
+    synched_ = th_.spawn_aux(std::forward<Fn>(f),
+      std::make_tuple(std::forward<Args>(args)...),
+      [=] (bool parent_popped) {
+        // on-die callback
+        if (!parent_popped) {
+          iro::release();
+        }
+      });
+  }
+
+public:
+  using join_state = ito_future_join_state_workfirst;
+
+  template <typename Fn, typename... Args>
+  explicit ito_future_workfirst(Fn&& f, Args&&... args) {
+    iro::poll();
+
+    iro::release();
+
+    initial_rank_ = P::rank();
+    spawn(std::forward<Fn>(f), std::forward<Args>(args)...);
+    if (!synched_) {
+      iro::acquire();
+    }
+
+    iro::poll();
+  }
+
+  static void join_begin(join_state&) {}
+
+  static void join_end(join_state& s) {
+    if (s.needs_acquire || s.blocked) {
+      iro::acquire();
+    }
+    iro::poll();
+  }
+
+  T join(join_state& s) {
+    iro::poll();
+    s.needs_acquire |= initial_rank_ != P::rank() || !synched_;
+    return th_.join_aux(0, [&s] {
+      // on-block callback
+      if (!s.blocked) {
+        iro::release();
+        s.blocked = true;
+      }
+    });
+  }
+};
+
+template <typename P, typename T>
+class ito_future_workfirst_lazy : public ito_future_workfirst<P, T> {
+  using base_t = ito_future_workfirst<P, T>;
+
+public:
+  template <typename Fn, typename... Args>
+  explicit ito_future_workfirst_lazy(Fn&& f, Args&&... args)
+    : base_t(typename base_t::lazy_release{}, std::forward<Fn>(f), std::forward<Args>(args)...) {}
+};
+
+struct ito_future_policy_default {
+  template <typename P_, typename T>
+  using ito_future_impl_t = ito_future_serial<P_, T>;
+  using iro = iro_if<iro_policy_default>;
+  static int rank() { return 0; }
+  static int n_ranks() { return 1; }
+};
+
+}
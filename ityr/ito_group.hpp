@@ -1,11 +1,172 @@
 #pragma once
 
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <utility>
+#include <vector>
+
 #include "uth.h"
 
 #include "ityr/iro.hpp"
 
 namespace ityr {
 
+// MaxTasks value for task groups that can spawn any number of tasks
+inline constexpr std::size_t dynamic_tasks = 0;
+
+template <typename P, std::size_t MaxTasks>
+class ito_group_tasks {
+  madm::uth::thread<void> tasks_[MaxTasks];
+  std::size_t n_ = 0;
+
+public:
+  static constexpr bool spawn_all = false;
+
+  bool is_last() const { return n_ == MaxTasks - 1; }
+
+  madm::uth::thread<void>* slot() {
+    assert(n_ < MaxTasks);
+    return &tasks_[n_];
+  }
+
+  void push() { n_++; }
+
+  template <typename Fn>
+  void for_each(Fn&& f) {
+    for (std::size_t i = 0; i < n_; i++) {
+      f(tasks_[i]);
+    }
+  }
+
+  void clear() { n_ = 0; }
+};
+
+// Up to InlineTasks thread handles are stored in the group itself. Further handles spill
+// into chunks of global memory, as the group object may migrate with its owner thread.
+// Chunk k holds (InlineTasks << k) handles and is allocated with malloc_local() by the rank
+// that spawns its first task. That rank accesses the chunk through its raw address, as local
+// allocations are mapped at their global addresses, and other ranks use put/get_nocache.
+// At wait(), chunks owned by the current rank go back to its per-size LIFO free lists, and
+// chunks owned by other ranks are freed, so each free list holds only local chunks.
+// Thread handles are assumed to be relocatable by copying their bytes.
+template <typename P>
+class ito_group_tasks<P, dynamic_tasks> {
+  using iro = typename P::iro;
+  using thread_t = madm::uth::thread<void>;
+  using chunk_t = typename iro::template global_ptr<std::byte>;
+
+  static constexpr std::size_t inline_tasks = 8;
+  static constexpr std::size_t max_chunks = 24;
+  static constexpr std::size_t max_free_chunks = 16;
+
+  static constexpr std::size_t chunk_tasks(std::size_t k) { return inline_tasks << k; }
+  static constexpr std::size_t chunk_bytes(std::size_t k) { return chunk_tasks(k) * sizeof(thread_t); }
+
+  static std::vector<chunk_t>& free_chunks(std::size_t k) {
+    static std::vector<chunk_t> free_chunks_[max_chunks];
+    return free_chunks_[k];
+  }
+
+  static chunk_t chunk_alloc(std::size_t k) {
+    auto& fc = free_chunks(k);
+    if (fc.empty()) {
+      return iro::template malloc_local<std::byte>(chunk_bytes(k));
+    }
+    chunk_t c = fc.back();
+    fc.pop_back();
+    return c;
+  }
+
+  static void chunk_free(std::size_t k, chunk_t c, int owner) {
+    auto& fc = free_chunks(k);
+    if (owner == P::rank() && fc.size() < max_free_chunks) {
+      fc.push_back(c);
+    } else {
+      iro::free(c, chunk_bytes(k));
+    }
+  }
+
+  alignas(thread_t) std::byte inline_[inline_tasks][sizeof(thread_t)];
+  alignas(thread_t) std::byte spill_[sizeof(thread_t)];
+  chunk_t chunks_[max_chunks];
+  int chunk_owners_[max_chunks];
+  std::size_t n_ = 0;
+
+  // returns (chunk index, offset in chunk) of spilled task i (i >= inline_tasks)
+  static std::pair<std::size_t, std::size_t> locate(std::size_t i) {
+    std::size_t k = 0;
+    i -= inline_tasks;
+    while (i >= chunk_tasks(k)) {
+      i -= chunk_tasks(k);
+      k++;
+    }
+    return {k, i};
+  }
+
+  static thread_t* as_thread(std::byte* p) {
+    return std::launder(reinterpret_cast<thread_t*>(p));
+  }
+
+public:
+  static constexpr bool spawn_all = true;
+
+  bool is_last() const { return false; }
+
+  thread_t* slot() {
+    return as_thread(n_ < inline_tasks ? inline_[n_] : spill_);
+  }
+
+  void push() {
+    if (n_ >= inline_tasks) {
+      auto [k, i] = locate(n_);
+      assert(k < max_chunks);
+      if (i == 0) {
+        chunks_[k] = chunk_alloc(k);
+        chunk_owners_[k] = P::rank();
+      }
+      auto p = chunks_[k] + i * sizeof(thread_t);
+      if (chunk_owners_[k] == P::rank()) {
+        std::memcpy(p.raw_ptr(), spill_, sizeof(thread_t));
+      } else {
+        iro::put_nocache(spill_, p, sizeof(thread_t));
+      }
+    }
+    n_++;
+  }
+
+  template <typename Fn>
+  void for_each(Fn&& f) {
+    for (std::size_t i = 0; i < std::min(n_, inline_tasks); i++) {
+      f(*as_thread(inline_[i]));
+    }
+    std::size_t k = 0, j = 0;
+    for (std::size_t i = inline_tasks; i < n_; i++) {
+      auto p = chunks_[k] + j * sizeof(thread_t);
+      if (chunk_owners_[k] == P::rank()) {
+        std::memcpy(spill_, p.raw_ptr(), sizeof(thread_t));
+      } else {
+        iro::get_nocache(p, spill_, sizeof(thread_t));
+      }
+      f(*as_thread(spill_));
+      if (++j == chunk_tasks(k)) {
+        k++;
+        j = 0;
+      }
+    }
+  }
+
+  void clear() {
+    if (n_ > inline_tasks) {
+      std::size_t k_last = locate(n_ - 1).first;
+      for (std::size_t k = 0; k <= k_last; k++) {
+        chunk_free(k, chunks_[k], chunk_owners_[k]);
+      }
+    }
+    n_ = 0;
+  }
+};
+
 template <typename P, std::size_t MaxTasks, bool SpawnLastTask>
 class ito_group_if {
   typename P::template ito_group_impl_t<P, MaxTasks, SpawnLastTask> impl_;
@@ -36,22 +197,21 @@ template <typename P, std::size_t MaxTasks, bool SpawnLastTask>
 class ito_group_naive {
   using iro = typename P::iro;
 
-  madm::uth::thread<void> tasks_[MaxTasks];
-  std::size_t n_ = 0;
+  ito_group_tasks<P, MaxTasks> tasks_;
 
 public:
   ito_group_naive() {}
 
   template <typename Fn, typename... Args>
   void run(Fn&& f, Args&&... args) {
-    assert(n_ < MaxTasks);
-    if (SpawnLastTask || n_ < MaxTasks - 1) {
+    if (tasks_.spawn_all || SpawnLastTask || !tasks_.is_last()) {
       iro::release();
-      new (&tasks_[n_++]) madm::uth::thread<void>{[=] {
+      new (tasks_.slot()) madm::uth::thread<void>{[=] {
         iro::acquire();
         f(args...);
         iro::release();
       }};
+      tasks_.push();
       iro::acquire();
     } else {
       std::forward<Fn>(f)(std::forward<Args>(args)...);
@@ -60,11 +220,9 @@ public:
 
   void wait() {
     iro::release();
-    for (std::size_t i = 0; i < n_; i++) {
-      tasks_[i].join();
-    }
+    tasks_.for_each([](madm::uth::thread<void>& th) { th.join(); });
     iro::acquire();
-    n_ = 0;
+    tasks_.clear();
   }
 };
 
@@ -72,10 +230,9 @@ template <typename P, std::size_t MaxTasks, bool SpawnLastTask>
 class ito_group_workfirst {
   using iro = typename P::iro;
 
-  madm::uth::thread<void> tasks_[MaxTasks];
+  ito_group_tasks<P, MaxTasks> tasks_;
   bool all_synched_ = true;
   int initial_rank;
-  std::size_t n_ = 0;
 
 public:
   ito_group_workfirst() { initial_rank = P::rank(); }
@@ -84,9 +241,8 @@ public:
   void run(Fn&& f, Args&&... args) {
     iro::poll();
 
-    assert(n_ < MaxTasks);
-    if (SpawnLastTask || n_ < MaxTasks - 1) {
-      auto p_th = &tasks_[n_];
+    if (tasks_.spawn_all || SpawnLastTask || !tasks_.is_last()) {
+      auto p_th = tasks_.slot();
       iro::release();
       new (p_th) madm::uth::thread<void>{};
       bool synched = p_th->spawn_aux(std::forward<Fn>(f),
@@ -101,7 +257,7 @@ public:
         iro::acquire();
       }
       all_synched_ &= synched;
-      n_++;
+      tasks_.push();
     } else {
       std::forward<Fn>(f)(std::forward<Args>(args)...);
     }
@@ -111,21 +267,21 @@ public:
 
   void wait() {
     bool blocked = false;
-    for (std::size_t i = 0; i < n_; i++) {
+    tasks_.for_each([&blocked](madm::uth::thread<void>& th) {
       iro::poll();
-      tasks_[i].join_aux(0, [&blocked] {
+      th.join_aux(0, [&blocked] {
         // on-block callback
         if (!blocked) {
           iro::release();
           blocked = true;
         }
       });
-    }
+    });
     if (initial_rank != P::rank() || !all_synched_ || blocked) {
       // FIXME: (all_synched && blocked) is true only for root tasks
       iro::acquire();
     }
-    n_ = 0;
+    tasks_.clear();
 
     iro::poll();
   }
@@ -135,10 +291,9 @@ template <typename P, std::size_t MaxTasks, bool SpawnLastTask>
 class ito_group_workfirst_lazy {
   using iro = typename P::iro;
 
-  madm::uth::thread<void> tasks_[MaxTasks];
+  ito_group_tasks<P, MaxTasks> tasks_;
   bool all_synched_ = true;
   int initial_rank;
-  std::size_t n_ = 0;
 
 public:
   ito_group_workfirst_lazy() { initial_rank = P::rank(); }
@@ -147,12 +302,11 @@ public:
   void run(Fn&& f, Args&&... args) {
     iro::poll();
 
-    assert(n_ < MaxTasks);
-    if (SpawnLastTask || n_ < MaxTasks - 1) {
+    if (tasks_.spawn_all || SpawnLastTask || !tasks_.is_last()) {
       typename iro::release_handler rh;
       iro::release_lazy(&rh);
 
-      auto p_th = &tasks_[n_];
+      auto p_th = tasks_.slot();
       new (p_th) madm::uth::thread<void>{};
       bool synched = p_th->spawn_aux(std::forward<Fn>(f),
         std::make_tuple(std::forward<Args>(args)...),
@@ -166,7 +320,7 @@ public:
         iro::acquire(rh);
       }
       all_synched_ &= synched;
-      n_++;
+      tasks_.push();
     } else {
       std::forward<Fn>(f)(std::forward<Args>(args)...);
     }
@@ -176,21 +330,21 @@ public:
 
   void wait() {
     bool blocked = false;
-    for (std::size_t i = 0; i < n_; i++) {
+    tasks_.for_each([&blocked](madm::uth::thread<void>& th) {
       iro::poll();
-      tasks_[i].join_aux(0, [&blocked] {
+      th.join_aux(0, [&blocked] {
         // on-block callback
         if (!blocked) {
           iro::release();
           blocked = true;
         }
       });
-    }
+    });
     if (initial_rank != P::rank() || !all_synched_ || blocked) {
       // FIXME: (all_synched && blocked) is true only for root tasks
       iro::acquire();
     }
-    n_ = 0;
+    tasks_.clear();
 
     iro::poll();
   }
@@ -1,70 +1,66 @@
 #pragma once
 
 #include <tuple>
+#include <utility>
+#include <type_traits>
+#include <optional>
 #include <functional>
+#include <vector>
 #include <mpi.h>
 
 #include "uth.h"
 
+#include "ityr/iterator.hpp"
 #include "ityr/iro.hpp"
 #include "ityr/iro_context.hpp"
 
-#define ITYR_CONCAT(a, b) a##b
-
-#define ITYR_FORLOOP_0(op, arg) op(0, arg)
-#define ITYR_FORLOOP_1(op, arg) ITYR_FORLOOP_0(op, arg) op(1, arg)
-#define ITYR_FORLOOP_2(op, arg) ITYR_FORLOOP_1(op, arg) op(2, arg)
-#define ITYR_FORLOOP_3(op, arg) ITYR_FORLOOP_2(op, arg) op(3, arg)
-#define ITYR_FORLOOP_4(op, arg) ITYR_FORLOOP_3(op, arg) op(4, arg)
-#define ITYR_FORLOOP_5(op, arg) ITYR_FORLOOP_4(op, arg) op(5, arg)
-#define ITYR_FORLOOP_6(op, arg) ITYR_FORLOOP_5(op, arg) op(6, arg)
-#define ITYR_FORLOOP_7(op, arg) ITYR_FORLOOP_6(op, arg) op(7, arg)
-#define ITYR_FORLOOP_8(op, arg) ITYR_FORLOOP_7(op, arg) op(8, arg)
-
-#define ITYR_FORLOOP_P_0(op)
-#define ITYR_FORLOOP_P_1(op) ITYR_FORLOOP_P_0(op) , op(1)
-#define ITYR_FORLOOP_P_2(op) ITYR_FORLOOP_P_1(op) , op(2)
-#define ITYR_FORLOOP_P_3(op) ITYR_FORLOOP_P_2(op) , op(3)
-#define ITYR_FORLOOP_P_4(op) ITYR_FORLOOP_P_3(op) , op(4)
-#define ITYR_FORLOOP_P_5(op) ITYR_FORLOOP_P_4(op) , op(5)
-#define ITYR_FORLOOP_P_6(op) ITYR_FORLOOP_P_5(op) , op(6)
-#define ITYR_FORLOOP_P_7(op) ITYR_FORLOOP_P_6(op) , op(7)
-#define ITYR_FORLOOP_P_8(op) ITYR_FORLOOP_P_7(op) , op(8)
-
-#define ITYR_FORLOOP_C_0(op)
-#define ITYR_FORLOOP_C_1(op) op(1)
-#define ITYR_FORLOOP_C_2(op) ITYR_FORLOOP_C_1(op) , op(2)
-#define ITYR_FORLOOP_C_3(op) ITYR_FORLOOP_C_2(op) , op(3)
-#define ITYR_FORLOOP_C_4(op) ITYR_FORLOOP_C_3(op) , op(4)
-#define ITYR_FORLOOP_C_5(op) ITYR_FORLOOP_C_4(op) , op(5)
-#define ITYR_FORLOOP_C_6(op) ITYR_FORLOOP_C_5(op) , op(6)
-#define ITYR_FORLOOP_C_7(op) ITYR_FORLOOP_C_6(op) , op(7)
-#define ITYR_FORLOOP_C_8(op) ITYR_FORLOOP_C_7(op) , op(8)
-
-#define ITYR_TEMPLATE_PARAM_STR(x) ITYR_CONCAT(typename Arg, x)
-#define ITYR_TYPENAME_STR(x) ITYR_CONCAT(Arg, x)
-#define ITYR_FUNC_PARAM_STR(x) ITYR_CONCAT(Arg, x)&& ITYR_CONCAT(arg, x)
-#define ITYR_FORWARD_ARG_STR(x) std::forward<ITYR_CONCAT(Arg, x)>(ITYR_CONCAT(arg, x))
-
-#define ITYR_PARALLEL_INVOKE_DEF_IMPL(n, impl) \
-  template <typename Fn ITYR_FORLOOP_P_##n(ITYR_TEMPLATE_PARAM_STR), \
-            typename... Rest, \
-            std::enable_if_t<std::is_invocable_v<Fn ITYR_FORLOOP_P_##n(ITYR_TYPENAME_STR)>, std::nullptr_t> = nullptr> \
-  auto parallel_invoke(Fn&& f ITYR_FORLOOP_P_##n(ITYR_FUNC_PARAM_STR), Rest&&... r) { \
-    return impl<std::invoke_result_t<Fn ITYR_FORLOOP_P_##n(ITYR_TYPENAME_STR)>>( \
-      f, \
-      std::make_tuple(ITYR_FORLOOP_C_##n(ITYR_FORWARD_ARG_STR)), \
-      std::forward<Rest>(r)... \
-    ); \
-  }
-
-#define ITYR_PARALLEL_INVOKE_DEF(n, impl) \
-  struct empty {}; \
-  auto parallel_invoke() { return std::make_tuple(); } \
-  ITYR_FORLOOP_##n(ITYR_PARALLEL_INVOKE_DEF_IMPL, impl)
-
 namespace ityr {
 
+// Splits parallel_invoke(f1, args1..., f2, args2..., ...) into (function, argument tuple)
+// pairs for Impl::parallel_invoke_impl. Each function takes as many of the following
+// arguments as it can be invoked with.
+template <typename Impl>
+struct parallel_invoke_parser {
+  struct empty {};
+
+  auto parallel_invoke() { return std::make_tuple(); }
+
+  template <typename Fn, typename... Rest>
+  auto parallel_invoke(Fn&& f, Rest&&... r) {
+    constexpr std::size_t n_args = invoke_arity<Fn, std::tuple<Rest...>, sizeof...(Rest)>();
+    return split<n_args>(std::forward<Fn>(f),
+                         std::forward_as_tuple(std::forward<Rest>(r)...),
+                         std::make_index_sequence<n_args>{},
+                         std::make_index_sequence<sizeof...(Rest) - n_args>{});
+  }
+
+private:
+  template <typename Fn, typename ArgsTuple, std::size_t... Is>
+  static constexpr bool invocable_with(std::index_sequence<Is...>) {
+    return std::is_invocable_v<Fn, std::tuple_element_t<Is, ArgsTuple>...>;
+  }
+
+  template <typename Fn, typename ArgsTuple, std::size_t N>
+  static constexpr std::size_t invoke_arity() {
+    if constexpr (invocable_with<Fn, ArgsTuple>(std::make_index_sequence<N>{})) {
+      return N;
+    } else {
+      static_assert(N > 0, "parallel_invoke: function is not invocable with the given arguments");
+      return invoke_arity<Fn, ArgsTuple, N - 1>();
+    }
+  }
+
+  template <std::size_t N, typename Fn, typename RestTuple, std::size_t... Is, std::size_t... Js>
+  auto split(Fn&& f, RestTuple&& r, std::index_sequence<Is...>, std::index_sequence<Js...>) {
+    using ret_t = std::invoke_result_t<Fn, std::tuple_element_t<Is, RestTuple>...>;
+    return static_cast<Impl&>(*this).template parallel_invoke_impl<ret_t>(
+      std::forward<Fn>(f),
+      std::make_tuple(std::get<Is>(std::move(r))...),
+      std::get<N + Js>(std::move(r))...
+    );
+  }
+};
+
 template <typename Iterator>
 using iterator_diff_t = typename std::iterator_traits<Iterator>::difference_type;
 
@@ -103,17 +99,217 @@ inline auto transfer_global_ptr_iter_param(Iter it) {
   }
 }
 
+// Pass as cutoff to let the parallel patterns choose the grain size
+inline constexpr std::ptrdiff_t auto_cutoff = 0;
+
+// Grain size for auto_cutoff, so that leaves line up with the blocks of the global memory
+template <typename P, typename ForwardIterator>
+inline iterator_diff_t<ForwardIterator> auto_grain() {
+  if constexpr (pcas::is_global_ptr_v<ForwardIterator>) {
+    using value_type = typename std::iterator_traits<ForwardIterator>::value_type;
+    return std::max(std::size_t(1), P::iro::block_size / sizeof(value_type));
+  } else {
+    return 1;
+  }
+}
+
+template <typename P, typename ForwardIterator>
+inline iterator_diff_t<ForwardIterator> resolve_cutoff(iterator_diff_t<ForwardIterator> cutoff) {
+  return (cutoff == auto_cutoff) ? auto_grain<P, ForwardIterator>() : cutoff;
+}
+
+// Decides how far the workfirst patterns split a range.
+// With a fixed cutoff, ranges are halved until they have at most cutoff elements.
+// With auto_cutoff (lazy binary splitting), ranges are split at grain boundaries only for a
+// limited depth, which is extended whenever the continuation of a split is stolen.
+template <typename Diff>
+struct splitter {
+  static constexpr int steal_depth = 2;
+
+  Diff        grain;
+  int         depth;      // remaining splits (negative for fixed cutoff)
+  std::size_t block_size; // in bytes; nonzero for global ranges with auto_cutoff
+
+  bool should_split(Diff d) const {
+    return d > grain && depth != 0;
+  }
+
+  // Splits [first, first + d) at the middle. With auto_cutoff, the split point is rounded up
+  // to the next block boundary of the global address of first (or grain boundary of a raw range).
+  template <typename ForwardIterator>
+  Diff mid(ForwardIterator first, Diff d) const {
+    if (depth < 0) return d / 2;
+    if constexpr (pcas::is_global_ptr_v<ForwardIterator>) {
+      if (block_size > 0) {
+        using value_type = typename std::iterator_traits<ForwardIterator>::value_type;
+        auto addr = reinterpret_cast<std::uintptr_t>(first.raw_ptr());
+        auto blk = (addr + d / 2 * sizeof(value_type) + block_size - 1) / block_size * block_size;
+        if (blk >= addr + d * sizeof(value_type)) {
+          blk -= block_size;
+        }
+        // the first element that starts at or after the block boundary
+        auto m = Diff((blk - addr + sizeof(value_type) - 1) / sizeof(value_type));
+        return (0 < m && m < d) ? m : d / 2;
+      }
+    }
+    return (d + grain - 1) / grain / 2 * grain;
+  }
+
+  splitter split(bool stolen) const {
+    if (depth < 0) return *this;
+    return {grain, depth - 1 + (stolen ? steal_depth : 0), block_size};
+  }
+};
+
+template <typename P, typename ForwardIterator>
+inline auto make_splitter(iterator_diff_t<ForwardIterator> cutoff) {
+  using splitter_t = splitter<iterator_diff_t<ForwardIterator>>;
+  if (cutoff == auto_cutoff) {
+    // about 2^steal_depth leaves per rank to begin with
+    int depth = splitter_t::steal_depth;
+    while ((1 << depth) < (P::n_ranks() << splitter_t::steal_depth)) depth++;
+    std::size_t block_size = 0;
+    if constexpr (pcas::is_global_ptr_v<ForwardIterator>) {
+      block_size = P::iro::block_size;
+    }
+    return splitter_t{auto_grain<P, ForwardIterator>(), depth, block_size};
+  } else {
+    return splitter_t{cutoff, -1, 0};
+  }
+}
+
+// Calls f with an iterator of [it, it + n), checking out the region if it is global.
+// An empty region is not checked out and the iterator is passed as is.
+template <typename P, typename P::iro::access_mode Mode,
+          typename ForwardIterator, typename Fn>
+inline void with_checkout_if_global(ForwardIterator                  it,
+                                    iterator_diff_t<ForwardIterator> n,
+                                    Fn&&                             f) {
+  if constexpr (P::auto_checkout && pcas::is_global_ptr_v<ForwardIterator>) {
+    if (n > 0) {
+      P::iro_context::template with_checkout<Mode>(it, n, std::forward<Fn>(f));
+      return;
+    }
+  }
+  std::forward<Fn>(f)(it);
+}
+
+template <typename P, typename P::iro::access_mode Mode, typename P::iro::access_mode... Modes,
+          typename Fn, typename ForwardIterator, typename... ForwardIterators>
+inline void with_checkouts_if_global_nested(std::ptrdiff_t      n,
+                                            Fn&&                f,
+                                            ForwardIterator     it,
+                                            ForwardIterators... its) {
+  auto g = [&](auto it_) {
+    if constexpr (sizeof...(Modes) == 0) {
+      std::forward<Fn>(f)(it_);
+    } else {
+      with_checkouts_if_global_nested<P, Modes...>(n, [&](auto... its_) {
+        std::forward<Fn>(f)(it_, its_...);
+      }, its...);
+    }
+  };
+  if constexpr (P::auto_checkout && pcas::is_global_ptr_v<ForwardIterator>) {
+    P::iro_context::template with_checkout<Mode>(it, n, [&](auto&& it_) {
+      g(transfer_global_ptr_iter_param<ForwardIterator>(it_));
+    });
+  } else {
+    g(it);
+  }
+}
+
+// Calls f(it1', ..., itN') with iterators of the regions [it_i, it_i + n) (n > 0),
+// checking out the global ones. Reads of all global regions are issued before
+// checking out any of them so that their latencies overlap.
+template <typename P, typename P::iro::access_mode... Modes,
+          typename Fn, typename... ForwardIterators>
+inline void with_checkouts_if_global(std::ptrdiff_t      n,
+                                     Fn&&                f,
+                                     ForwardIterators... its) {
+  static_assert(sizeof...(Modes) == sizeof...(ForwardIterators));
+  assert(n > 0);
+  if constexpr (P::auto_checkout && sizeof...(Modes) > 1) {
+    ([&]() {
+      if constexpr (pcas::is_global_ptr_v<ForwardIterators> && Modes != P::iro::access_mode::write) {
+        P::iro::willread(its, n);
+      }
+    }(), ...);
+  }
+  with_checkouts_if_global_nested<P, Modes...>(n, std::forward<Fn>(f), its...);
+}
+
+// Issues reads of the regions [it_i, it_i + n) in advance for the global ones to be read
+template <typename P, typename P::iro::access_mode... Modes, typename... ForwardIterators>
+inline void willread_if_global(std::ptrdiff_t n, ForwardIterators... its) {
+  static_assert(sizeof...(Modes) == sizeof...(ForwardIterators));
+  if (n <= 0) return;
+  ([&]() {
+    if constexpr (P::auto_checkout && pcas::is_global_ptr_v<ForwardIterators> &&
+                  Modes != P::iro::access_mode::write) {
+      P::iro::willread(its, n);
+    }
+  }(), ...);
+}
+
+// Iterates over [first1, last1) and the ranges beginning at firsts in lockstep,
+// checking out cutoff elements of all global ranges at a time.
+// If prefetch is true, the next chunk is requested before the current one is processed.
+template <typename P, typename P::iro::access_mode... Modes,
+          typename ForwardIterator1, typename... ForwardIterators, typename Fn>
+inline void for_each_serial_n(ForwardIterator1                  first1,
+                              ForwardIterator1                  last1,
+                              std::tuple<ForwardIterators...>   firsts,
+                              Fn&&                              f,
+                              iterator_diff_t<ForwardIterator1> cutoff,
+                              bool                              prefetch = P::prefetch_next_chunk) {
+  static_assert(sizeof...(Modes) == sizeof...(ForwardIterators) + 1);
+  if constexpr (P::auto_checkout &&
+                (pcas::is_global_ptr_v<ForwardIterator1> || ... || pcas::is_global_ptr_v<ForwardIterators>)) {
+    auto n = std::distance(first1, last1);
+    for (std::ptrdiff_t d = 0; d < n; d += cutoff) {
+      auto n_ = std::min(n - d, cutoff);
+      std::apply([&](auto... firsts_) {
+        with_checkouts_if_global<P, Modes...>(n_, [&](auto it1, auto... its) {
+          if (prefetch) {
+            auto n_next = std::min(n - d - n_, cutoff);
+            willread_if_global<P, Modes...>(n_next, std::next(first1, d + n_), std::next(firsts_, d + n_)...);
+          }
+          for (std::ptrdiff_t i = 0; i < n_; i++, ++it1, ((++its), ...)) {
+            std::forward<Fn>(f)(*it1, *its...);
+          }
+        }, std::next(first1, d), std::next(firsts_, d)...);
+      }, firsts);
+    }
+
+  } else {
+    std::apply([&](auto... its) {
+      for (; first1 != last1; ++first1, ((++its), ...)) {
+        std::forward<Fn>(f)(*first1, *its...);
+      }
+    }, firsts);
+  }
+}
+
+template <typename... ForwardIterators, typename Diff>
+inline std::tuple<ForwardIterators...> next_all(const std::tuple<ForwardIterators...>& its, Diff d) {
+  return std::apply([&](auto... its_) { return std::make_tuple(std::next(its_, d)...); }, its);
+}
+
 template <typename P, typename P::iro::access_mode Mode,
           typename ForwardIterator, typename Fn>
 inline void for_each_serial(ForwardIterator                  first,
                             ForwardIterator                  last,
                             Fn&&                             f,
-                            iterator_diff_t<ForwardIterator> cutoff) {
+                            iterator_diff_t<ForwardIterator> cutoff,
+                            bool                             prefetch = P::prefetch_next_chunk) {
   if constexpr (P::auto_checkout && pcas::is_global_ptr_v<ForwardIterator>) {
     auto n = std::distance(first, last);
     for (std::ptrdiff_t d = 0; d < n; d += cutoff) {
       auto n_ = std::min(n - d, cutoff);
       P::iro_context::template with_checkout<Mode>(std::next(first, d), n_, [&](auto&& it_) {
+        if (prefetch) {
+          willread_if_global<P, Mode>(std::min(n - d - n_, cutoff), std::next(first, d + n_));
+        }
         auto it = transfer_global_ptr_iter_param<ForwardIterator>(it_);
         for_each_serial<P, Mode>(it, std::next(it, n_), std::forward<Fn>(f), cutoff);
       });
@@ -132,34 +328,9 @@ inline void for_each_serial(ForwardIterator1                  first1,
                             ForwardIterator1                  last1,
                             ForwardIterator2                  first2,
                             Fn&&                              f,
-                            iterator_diff_t<ForwardIterator1> cutoff) {
-  if constexpr (P::auto_checkout && pcas::is_global_ptr_v<ForwardIterator1>) {
-    auto n = std::distance(first1, last1);
-    for (std::ptrdiff_t d = 0; d < n; d += cutoff) {
-      auto n_ = std::min(n - d, cutoff);
-      P::iro_context::template with_checkout<Mode1>(std::next(first1, d), n_, [&](auto&& it1_) {
-        auto it1 = transfer_global_ptr_iter_param<ForwardIterator1>(it1_);
-        auto it2 = std::next(first2, d);
-        for_each_serial<P, Mode1, Mode2>(it1, std::next(it1, n_), it2, std::forward<Fn>(f), cutoff);
-      });
-    }
-
-  } else if constexpr (P::auto_checkout && pcas::is_global_ptr_v<ForwardIterator2>) {
-    auto n = std::distance(first1, last1);
-    for (std::ptrdiff_t d = 0; d < n; d += cutoff) {
-      auto n_ = std::min(n - d, cutoff);
-      P::iro_context::template with_checkout<Mode2>(std::next(first2, d), n_, [&](auto&& it2_) {
-        auto it1 = std::next(first1, d);
-        auto it2 = transfer_global_ptr_iter_param<ForwardIterator2>(it2_);
-        for_each_serial<P, Mode1, Mode2>(it1, std::next(it1, n_), it2, std::forward<Fn>(f), cutoff);
-      });
-    }
-
-  } else {
-    for (; first1 != last1; ++first1, ++first2) {
-      std::forward<Fn>(f)(*first1, *first2);
-    }
-  }
+                            iterator_diff_t<ForwardIterator1> cutoff,
+                            bool                              prefetch = P::prefetch_next_chunk) {
+  for_each_serial_n<P, Mode1, Mode2>(first1, last1, std::make_tuple(first2), std::forward<Fn>(f), cutoff, prefetch);
 }
 
 template <typename P, typename P::iro::access_mode Mode1, typename P::iro::access_mode Mode2, typename P::iro::access_mode Mode3,
@@ -169,48 +340,248 @@ inline void for_each_serial(ForwardIterator1                  first1,
                             ForwardIterator2                  first2,
                             ForwardIterator3                  first3,
                             Fn&&                              f,
-                            iterator_diff_t<ForwardIterator1> cutoff) {
-  if constexpr (P::auto_checkout && pcas::is_global_ptr_v<ForwardIterator1>) {
-    auto n = std::distance(first1, last1);
-    for (std::ptrdiff_t d = 0; d < n; d += cutoff) {
-      auto n_ = std::min(n - d, cutoff);
-      P::iro_context::template with_checkout<Mode1>(std::next(first1, d), n_, [&](auto&& it1_) {
-        auto it1 = transfer_global_ptr_iter_param<ForwardIterator1>(it1_);
-        auto it2 = std::next(first2, d);
-        auto it3 = std::next(first3, d);
-        for_each_serial<P, Mode1, Mode2, Mode3>(it1, std::next(it1, n_), it2, it3, std::forward<Fn>(f), cutoff);
-      });
-    }
+                            iterator_diff_t<ForwardIterator1> cutoff,
+                            bool                              prefetch = P::prefetch_next_chunk) {
+  for_each_serial_n<P, Mode1, Mode2, Mode3>(first1, last1, std::make_tuple(first2, first3),
+                                            std::forward<Fn>(f), cutoff, prefetch);
+}
 
-  } else if constexpr (P::auto_checkout && pcas::is_global_ptr_v<ForwardIterator2>) {
-    auto n = std::distance(first1, last1);
-    for (std::ptrdiff_t d = 0; d < n; d += cutoff) {
-      auto n_ = std::min(n - d, cutoff);
-      P::iro_context::template with_checkout<Mode2>(std::next(first2, d), n_, [&](auto&& it2_) {
-        auto it1 = std::next(first1, d);
-        auto it2 = transfer_global_ptr_iter_param<ForwardIterator2>(it2_);
-        auto it3 = std::next(first3, d);
-        for_each_serial<P, Mode1, Mode2, Mode3>(it1, std::next(it1, n_), it2, it3, std::forward<Fn>(f), cutoff);
-      });
+template <typename P, bool Inclusive,
+          typename ForwardIterator, typename ForwardIteratorR, typename T, typename BinaryOp>
+inline std::optional<T> scan_serial(ForwardIterator                  first,
+                                    ForwardIterator                  last,
+                                    ForwardIteratorR                 result,
+                                    std::optional<T>                 acc,
+                                    BinaryOp                         op,
+                                    iterator_diff_t<ForwardIterator> cutoff) {
+  using access_mode = typename P::iro::access_mode;
+  for_each_serial<P, access_mode::read, access_mode::write>(
+      first, last, result, [&](const auto& v, auto&& r) {
+    if constexpr (Inclusive) {
+      acc = acc.has_value() ? T(op(*acc, v)) : T(v);
+      r = *acc;
+    } else {
+      // compute the next value first so that the output can alias the input
+      T next = op(*acc, v);
+      r = *acc;
+      acc = std::move(next);
     }
+  }, cutoff);
+  return acc;
+}
 
-  } else if constexpr (P::auto_checkout && pcas::is_global_ptr_v<ForwardIterator3>) {
-    auto n = std::distance(first1, last1);
-    for (std::ptrdiff_t d = 0; d < n; d += cutoff) {
-      auto n_ = std::min(n - d, cutoff);
-      P::iro_context::template with_checkout<Mode3>(std::next(first3, d), n_, [&](auto&& it3_) {
-        auto it1 = std::next(first1, d);
-        auto it2 = std::next(first2, d);
-        auto it3 = transfer_global_ptr_iter_param<ForwardIterator3>(it3_);
-        for_each_serial<P, Mode1, Mode2, Mode3>(it1, std::next(it1, n_), it2, it3, std::forward<Fn>(f), cutoff);
-      });
+// Two-pass scan built on top of Impl::parallel_for:
+//   1. reduce each leaf block (one read checkout per block)
+//   2. scan the block sums recursively
+//   3. rescan each leaf block with its prefix (one read/write checkout per block)
+template <typename P, typename Impl, bool Inclusive,
+          typename ForwardIterator, typename ForwardIteratorR, typename T, typename BinaryOp>
+inline void scan_two_pass(ForwardIterator                  first,
+                          ForwardIterator                  last,
+                          ForwardIteratorR                 result,
+                          std::optional<T>                 init,
+                          BinaryOp                         op,
+                          iterator_diff_t<ForwardIterator> cutoff) {
+  using iro = typename P::iro;
+  using iro_context = typename P::iro_context;
+  using access_mode = typename iro::access_mode;
+  using diff_t = iterator_diff_t<ForwardIterator>;
+
+  // The block sums are scanned with the same algorithm, so each level must shrink
+  diff_t bs = std::max(cutoff, diff_t(2));
+  diff_t n = std::distance(first, last);
+  if (n <= bs) {
+    scan_serial<P, Inclusive>(first, last, result, init, op, cutoff);
+    return;
+  }
+
+  diff_t n_blocks = (n + bs - 1) / bs;
+  auto block_sums   = iro::template malloc_local<T>(n_blocks);
+  auto block_prefix = iro::template malloc_local<T>(n_blocks);
+
+  Impl::template parallel_for<access_mode::read>(
+      count_iterator<diff_t>(0), count_iterator<diff_t>(n_blocks), [=](diff_t b) {
+    auto b_first = std::next(first, b * bs);
+    auto b_last  = std::next(first, std::min((b + 1) * bs, n));
+    std::optional<T> acc;
+    for_each_serial<P, access_mode::read>(b_first, b_last, [&](const auto& v) {
+      acc = acc.has_value() ? T(op(*acc, v)) : T(v);
+    }, bs);
+    iro_context::template with_checkout<access_mode::write>(block_sums + b, 1, [&](auto&& p) {
+      new (p) T(std::move(*acc));
+    });
+  }, 1);
+
+  scan_two_pass<P, Impl, true>(block_sums, block_sums + n_blocks, block_prefix,
+                               std::optional<T>{}, op, cutoff);
+
+  Impl::template parallel_for<access_mode::read>(
+      count_iterator<diff_t>(0), count_iterator<diff_t>(n_blocks), [=](diff_t b) {
+    std::optional<T> acc = init;
+    if (b > 0) {
+      T prev = iro_context::template with_checkout<access_mode::read>(
+          block_prefix + (b - 1), 1, [&](auto&& p) { return T(*p); });
+      acc = acc.has_value() ? T(op(*acc, prev)) : prev;
     }
+    auto b_first = std::next(first, b * bs);
+    auto b_last  = std::next(first, std::min((b + 1) * bs, n));
+    scan_serial<P, Inclusive>(b_first, b_last, std::next(result, b * bs), acc, op, bs);
+  }, 1);
+
+  if constexpr (!std::is_trivially_destructible_v<T>) {
+    for_each_serial<P, access_mode::read_write>(
+        block_sums, block_sums + n_blocks, [](auto&& x) { std::destroy_at(&x); }, n_blocks);
+    for_each_serial<P, access_mode::read_write>(
+        block_prefix, block_prefix + n_blocks, [](auto&& x) { std::destroy_at(&x); }, n_blocks);
+  }
+  iro::free(block_sums, n_blocks);
+  iro::free(block_prefix, n_blocks);
+}
 
-  } else {
-    for (; first1 != last1; ++first1, ++first2, ++first3) {
-      std::forward<Fn>(f)(*first1, *first2, *first3);
+// Stream compaction built on top of Impl::parallel_for:
+//   1. count the elements satisfying pred in each leaf block
+//   2. scan the counts to get the output offset of each block
+//   3. copy the elements of each block with one write checkout per output chunk
+// If Partition is true, the elements not satisfying pred are stored after the others.
+// Both are stable. Returns the number of elements satisfying pred.
+template <typename P, typename Impl, bool Partition,
+          typename ForwardIterator, typename ForwardIteratorR, typename Predicate>
+inline iterator_diff_t<ForwardIterator>
+filter_two_pass(ForwardIterator                  first,
+                ForwardIterator                  last,
+                ForwardIteratorR                 result,
+                Predicate                        pred,
+                iterator_diff_t<ForwardIterator> cutoff) {
+  using iro = typename P::iro;
+  using iro_context = typename P::iro_context;
+  using access_mode = typename iro::access_mode;
+  using diff_t = iterator_diff_t<ForwardIterator>;
+
+  diff_t bs = std::max(cutoff, diff_t(1));
+  diff_t n = std::distance(first, last);
+  if (n == 0) {
+    return 0;
+  }
+
+  diff_t n_blocks = (n + bs - 1) / bs;
+  auto block_counts = iro::template malloc_local<diff_t>(n_blocks);
+  auto block_ends   = iro::template malloc_local<diff_t>(n_blocks);
+
+  Impl::template parallel_for<access_mode::read>(
+      count_iterator<diff_t>(0), count_iterator<diff_t>(n_blocks), [=](diff_t b) {
+    auto b_first = std::next(first, b * bs);
+    auto b_last  = std::next(first, std::min((b + 1) * bs, n));
+    diff_t count = 0;
+    for_each_serial<P, access_mode::read>(b_first, b_last, [&](const auto& v) {
+      if (pred(v)) count++;
+    }, bs);
+    iro_context::template with_checkout<access_mode::write>(block_counts + b, 1, [&](auto&& p) {
+      *p = count;
+    });
+  }, 1);
+
+  scan_two_pass<P, Impl, true>(block_counts, block_counts + n_blocks, block_ends,
+                               std::optional<diff_t>{}, std::plus<diff_t>{}, bs);
+
+  diff_t n_true = iro_context::template with_checkout<access_mode::read>(
+      block_ends + (n_blocks - 1), 1, [&](auto&& p) { return *p; });
+
+  Impl::template parallel_for<access_mode::read>(
+      count_iterator<diff_t>(0), count_iterator<diff_t>(n_blocks), [=](diff_t b) {
+    auto [t_begin, t_end] = iro_context::template with_checkout<access_mode::read>(
+        block_ends + std::max(b - 1, diff_t(0)), std::min(b + 1, diff_t(2)), [&](auto&& p) {
+      return (b == 0) ? std::make_pair(diff_t(0), p[0]) : std::make_pair(p[0], p[1]);
+    });
+
+    diff_t i_begin = b * bs;
+    diff_t i_end   = std::min((b + 1) * bs, n);
+    auto b_first = std::next(first, i_begin);
+    auto b_last  = std::next(first, i_end);
+
+    with_checkout_if_global<P, access_mode::write>(
+        std::next(result, t_begin), t_end - t_begin, [&](auto out_t) {
+      if constexpr (Partition) {
+        diff_t f_begin = n_true + i_begin - t_begin;
+        diff_t f_end   = n_true + i_end - t_end;
+        with_checkout_if_global<P, access_mode::write>(
+            std::next(result, f_begin), f_end - f_begin, [&](auto out_f) {
+          for_each_serial<P, access_mode::read>(b_first, b_last, [&](const auto& v) {
+            if (pred(v)) *out_t++ = v;
+            else         *out_f++ = v;
+          }, bs);
+        });
+      } else {
+        for_each_serial<P, access_mode::read>(b_first, b_last, [&](const auto& v) {
+          if (pred(v)) *out_t++ = v;
+        }, bs);
+      }
+    });
+  }, 1);
+
+  iro::free(block_counts, n_blocks);
+  iro::free(block_ends, n_blocks);
+
+  return n_true;
+}
+
+// The smallest index found so far by a parallel search, shared among tasks on any rank.
+// It is only a hint to skip the subranges that cannot contain the first match;
+// the result of the search is determined by the indices returned by the tasks.
+// It is an iro atomic word, so each get() or update() is a round trip to the rank that
+// created it; searches read it only at leaves and where a continuation has been stolen.
+template <typename P, typename Diff>
+class find_index {
+  using iro = typename P::iro;
+
+  typename iro::template global_atomic_ptr<Diff> p_;
+  Diff                                           none_;
+
+public:
+  explicit find_index(Diff none) : p_(iro::malloc_atomic(none)), none_(none) {}
+
+  void destroy() { iro::free_atomic(p_); }
+
+  Diff none() const { return none_; }
+
+  Diff get() const { return iro::load(p_); }
+
+  void update(Diff i) const {
+    if (i != none_) {
+      iro::fetch_min(p_, i);
     }
   }
+};
+
+// Returns offset + (the index of the first element in [first, last) satisfying pred),
+// or none if not found. The chunk beginning at offset + i is not searched if skip(offset + i).
+template <typename P, typename ForwardIterator, typename Predicate, typename SkipFn>
+inline iterator_diff_t<ForwardIterator> find_if_serial(ForwardIterator                  first,
+                                                       ForwardIterator                  last,
+                                                       iterator_diff_t<ForwardIterator> offset,
+                                                       iterator_diff_t<ForwardIterator> none,
+                                                       Predicate                        pred,
+                                                       iterator_diff_t<ForwardIterator> cutoff,
+                                                       SkipFn                           skip) {
+  using diff_t = iterator_diff_t<ForwardIterator>;
+  using access_mode = typename P::iro::access_mode;
+
+  auto d = std::distance(first, last);
+  for (diff_t i = 0; i < d; i += cutoff) {
+    if (skip(offset + i)) break;
+
+    auto n = std::min(cutoff, d - i);
+    diff_t ret = none;
+    with_checkout_if_global<P, access_mode::read>(std::next(first, i), n, [&](auto it) {
+      for (diff_t j = 0; j < n; j++, ++it) {
+        if (pred(*it)) {
+          ret = offset + i + j;
+          return;
+        }
+      }
+    });
+    if (ret != none) return ret;
+  }
+  return none;
 }
 
 template <typename P>
@@ -220,6 +591,88 @@ class ito_pattern_if {
   using iro_context = typename P::iro_context;
   using access_mode = typename iro::access_mode;
 
+  template <std::size_t Offset, typename Tuple, std::size_t... Is>
+  static auto tuple_slice(const Tuple& t, std::index_sequence<Is...>) {
+    return std::make_tuple(std::get<Offset + Is>(t)...);
+  }
+
+  // Calls chunk_fn(b, e) for chunks [b, e) of [first, last), cut at the home block boundaries
+  // of a global range. Each process first claims the chunks it owns, and then steals those of
+  // the other processes. Claims are atomic increments of a per-owner counter (an iro atomic
+  // word); the owner claims its chunks in batches of a quarter of what is left, and thieves
+  // claim one chunk at a time so that they can still share the tail of a busy owner.
+  // Raw ranges are private to each process, so each process runs all of their chunks.
+  template <typename ForwardIterator, typename ChunkFn>
+  static void for_each_chunk_owner_first(ForwardIterator                  first,
+                                         ForwardIterator                  last,
+                                         iterator_diff_t<ForwardIterator> cutoff,
+                                         ChunkFn&&                        chunk_fn) {
+    using diff_t = iterator_diff_t<ForwardIterator>;
+    auto n = std::distance(first, last);
+    int n_ranks = P::n_ranks();
+
+    if constexpr (!pcas::is_global_ptr_v<ForwardIterator>) {
+      for (diff_t b = 0; b < n; b += cutoff) {
+        chunk_fn(b, std::min(b + cutoff, n));
+      }
+      return;
+    }
+
+    std::vector<diff_t> bounds{0};
+    if constexpr (pcas::is_global_ptr_v<ForwardIterator>) {
+      if (iro::block_size > 0) {
+        using value_type = typename std::iterator_traits<ForwardIterator>::value_type;
+        auto addr = reinterpret_cast<std::uintptr_t>(first.raw_ptr());
+        for (auto blk = (addr / iro::block_size + 1) * iro::block_size; bounds.back() < n; blk += iro::block_size) {
+          // the first element that starts at or after the block boundary
+          auto i = diff_t((blk - addr + sizeof(value_type) - 1) / sizeof(value_type));
+          if (i > bounds.back()) bounds.push_back(std::min(i, n));
+        }
+      }
+    }
+    for (diff_t i = bounds.back() + cutoff; bounds.back() < n; i += cutoff) {
+      bounds.push_back(std::min(i, n));
+    }
+
+    std::vector<std::vector<std::size_t>> chunks(n_ranks);
+    for (std::size_t k = 0; k + 1 < bounds.size(); k++) {
+      int owner = -1;
+      if constexpr (pcas::is_global_ptr_v<ForwardIterator>) {
+        owner = iro::owner(std::next(first, bounds[k]));
+      }
+      chunks[owner >= 0 ? owner : k % n_ranks].push_back(k);
+    }
+
+    std::vector<typename iro::template global_atomic_ptr<std::size_t>> counters(n_ranks);
+    counters[P::rank()] = iro::malloc_atomic(std::size_t(0));
+    if (n_ranks > 1) {
+      MPI_Allgather(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL,
+                    counters.data(), sizeof(counters[0]), MPI_BYTE, MPI_COMM_WORLD);
+    }
+
+    const auto& mine = chunks[P::rank()];
+    std::size_t batch = std::max(mine.size() / 4, std::size_t(1));
+    for (std::size_t i; (i = iro::fetch_add(counters[P::rank()], batch)) < mine.size();) {
+      auto i_end = std::min(i + batch, mine.size());
+      for (; i < i_end; i++) {
+        auto k = mine[i];
+        chunk_fn(bounds[k], bounds[k + 1]);
+      }
+      batch = std::max((mine.size() - i_end) / 4, std::size_t(1));
+    }
+
+    for (int j = 1; j < n_ranks; j++) {
+      int r = (P::rank() + j) % n_ranks;
+      for (std::size_t i; (i = iro::fetch_add(counters[r], std::size_t(1))) < chunks[r].size();) {
+        auto k = chunks[r][i];
+        chunk_fn(bounds[k], bounds[k + 1]);
+      }
+    }
+
+    P::barrier();
+    iro::free_atomic(counters[P::rank()]);
+  }
+
 public:
   template <typename Fn, typename... Args>
   static auto root_spawn(Fn&& f, Args&&... args) {
@@ -261,8 +714,9 @@ public:
   static void serial_for(ForwardIterator                  first,
                          ForwardIterator                  last,
                          Fn&&                             f,
-                         iterator_diff_t<ForwardIterator> cutoff = {1}) {
-    for_each_serial<P, Mode>(first, last, f, cutoff);
+                         iterator_diff_t<ForwardIterator> cutoff = {1},
+                         bool                             prefetch = P::prefetch_next_chunk) {
+    for_each_serial<P, Mode>(first, last, f, resolve_cutoff<P, ForwardIterator>(cutoff), prefetch);
   }
 
   template <access_mode Mode1, access_mode Mode2,
@@ -271,8 +725,9 @@ public:
                          ForwardIterator1                  last1,
                          ForwardIterator2                  first2,
                          Fn&&                              f,
-                         iterator_diff_t<ForwardIterator1> cutoff = {1}) {
-    for_each_serial<P, Mode1, Mode2>(first1, last1, first2, f, cutoff);
+                         iterator_diff_t<ForwardIterator1> cutoff = {1},
+                         bool                              prefetch = P::prefetch_next_chunk) {
+    for_each_serial<P, Mode1, Mode2>(first1, last1, first2, f, resolve_cutoff<P, ForwardIterator1>(cutoff), prefetch);
   }
 
   template <access_mode Mode, typename ForwardIterator, typename Fn>
@@ -293,7 +748,58 @@ public:
                            Fn                                f,
                            iterator_diff_t<ForwardIterator1> cutoff = {1}) {
     iro_context::with_checkout_cancel([&]() {
-      impl::template parallel_for<Mode1, Mode2>(first1, last1, first2, f, cutoff);
+      impl::template parallel_for<Mode1, Mode2>(first1, last1, std::make_tuple(first2), f, cutoff);
+    });
+  }
+
+  // parallel_for<Mode1, ..., ModeN>(first1, last1, first2, ..., firstN, f[, cutoff]) for N >= 3
+  template <access_mode Mode1, access_mode Mode2, access_mode Mode3, access_mode... Modes,
+            typename... Args>
+  static void parallel_for(Args&&... args) {
+    constexpr std::size_t n_ranges = 3 + sizeof...(Modes);
+    static_assert(sizeof...(Args) == n_ranges + 2 || sizeof...(Args) == n_ranges + 3,
+                  "Arguments must be (first1, last1, first2, ..., firstN, f[, cutoff])");
+
+    auto args_ = std::forward_as_tuple(std::forward<Args>(args)...);
+    auto first1 = std::get<0>(args_);
+    auto last1 = std::get<1>(args_);
+    auto firsts = tuple_slice<2>(args_, std::make_index_sequence<n_ranges - 1>{});
+    auto f = std::get<n_ranges + 1>(args_);
+
+    iterator_diff_t<decltype(first1)> cutoff = {1};
+    if constexpr (sizeof...(Args) == n_ranges + 3) {
+      cutoff = std::get<n_ranges + 2>(args_);
+    }
+
+    iro_context::with_checkout_cancel([&]() {
+      impl::template parallel_for<Mode1, Mode2, Mode3, Modes...>(first1, last1, firsts, f, cutoff);
+    });
+  }
+
+  // Owner-compute variants of parallel_for. Collective over all processes outside of tasks.
+  // Chunks of the first range are run by the processes that own their home blocks first;
+  // the remaining chunks are then taken by idle processes.
+  template <access_mode Mode, typename ForwardIterator, typename Fn>
+  static void parallel_for_owner(ForwardIterator                  first,
+                                 ForwardIterator                  last,
+                                 Fn&&                             f,
+                                 iterator_diff_t<ForwardIterator> cutoff = {1}) {
+    cutoff = resolve_cutoff<P, ForwardIterator>(cutoff);
+    for_each_chunk_owner_first(first, last, cutoff, [&](auto b, auto e) {
+      for_each_serial<P, Mode>(std::next(first, b), std::next(first, e), f, cutoff);
+    });
+  }
+
+  template <access_mode Mode1, access_mode Mode2,
+            typename ForwardIterator1, typename ForwardIterator2, typename Fn>
+  static void parallel_for_owner(ForwardIterator1                  first1,
+                                 ForwardIterator1                  last1,
+                                 ForwardIterator2                  first2,
+                                 Fn&&                              f,
+                                 iterator_diff_t<ForwardIterator1> cutoff = {1}) {
+    cutoff = resolve_cutoff<P, ForwardIterator1>(cutoff);
+    for_each_chunk_owner_first(first1, last1, cutoff, [&](auto b, auto e) {
+      for_each_serial<P, Mode1, Mode2>(std::next(first1, b), std::next(first1, e), std::next(first2, b), f, cutoff);
     });
   }
 
@@ -304,12 +810,15 @@ public:
                            ReduceOp                         reduce,
                            iterator_diff_t<ForwardIterator> cutoff = {1}) {
     return iro_context::with_checkout_cancel([&]() {
-      auto transform = [](typename ForwardIterator::value_type&& v) { return std::forward(v); };
+      auto transform = [](const auto& v) { return v; };
       return impl::parallel_reduce(first, last, init, reduce, transform, cutoff);
     });
   }
 
-  template <typename ForwardIterator, typename T, typename ReduceOp, typename TransformOp>
+  // SFINAE for ambiguity in the default cutoff parameter above.
+  // The 'cutoff' parameter of the above function can match the 'transform' parameter here.
+  template <typename ForwardIterator, typename T, typename ReduceOp, typename TransformOp,
+            std::enable_if_t<not std::is_convertible_v<TransformOp, iterator_diff_t<ForwardIterator>>, std::nullptr_t> = nullptr>
   static T parallel_reduce(ForwardIterator                  first,
                            ForwardIterator                  last,
                            T                                init,
@@ -321,6 +830,21 @@ public:
     });
   }
 
+  // In-place variant for large or move-only accumulators. accumulate(acc, v) folds an
+  // element into acc and reduce(acc, other) merges other into acc. identity() creates an
+  // empty accumulator; it is called only at the top level and on stolen continuations.
+  template <typename ForwardIterator, typename IdentityFn, typename AccumulateOp, typename ReduceOp>
+  static auto parallel_reduce_inplace(ForwardIterator                  first,
+                                      ForwardIterator                  last,
+                                      IdentityFn                       identity,
+                                      AccumulateOp                     accumulate,
+                                      ReduceOp                         reduce,
+                                      iterator_diff_t<ForwardIterator> cutoff = {1}) {
+    return iro_context::with_checkout_cancel([&]() {
+      return impl::parallel_reduce_inplace(first, last, identity, accumulate, reduce, cutoff);
+    });
+  }
+
   template <typename ForwardIterator, typename ForwardIteratorR, class UnaryOp>
   static ForwardIteratorR parallel_transform(ForwardIterator                  first,
                                              ForwardIterator                  last,
@@ -346,6 +870,104 @@ public:
       return impl::parallel_transform(first1, last1, first2, result, binary_op, cutoff);
     });
   }
+
+  template <typename ForwardIterator, typename ForwardIteratorR, typename BinaryOp>
+  static ForwardIteratorR parallel_inclusive_scan(ForwardIterator                  first,
+                                                  ForwardIterator                  last,
+                                                  ForwardIteratorR                 result,
+                                                  BinaryOp                         op,
+                                                  iterator_diff_t<ForwardIterator> cutoff = {1}) {
+    using T = typename std::iterator_traits<ForwardIterator>::value_type;
+    return iro_context::with_checkout_cancel([&]() {
+      return impl::parallel_inclusive_scan(first, last, result, op, std::optional<T>{},
+                                           resolve_cutoff<P, ForwardIterator>(cutoff));
+    });
+  }
+
+  // No default cutoff here; otherwise a cutoff passed to the above function would be taken as 'init'
+  template <typename ForwardIterator, typename ForwardIteratorR, typename BinaryOp, typename T>
+  static ForwardIteratorR parallel_inclusive_scan(ForwardIterator                  first,
+                                                  ForwardIterator                  last,
+                                                  ForwardIteratorR                 result,
+                                                  BinaryOp                         op,
+                                                  T                                init,
+                                                  iterator_diff_t<ForwardIterator> cutoff) {
+    return iro_context::with_checkout_cancel([&]() {
+      return impl::parallel_inclusive_scan(first, last, result, op, std::optional<T>(init),
+                                           resolve_cutoff<P, ForwardIterator>(cutoff));
+    });
+  }
+
+  template <typename ForwardIterator, typename ForwardIteratorR, typename T, typename BinaryOp>
+  static ForwardIteratorR parallel_exclusive_scan(ForwardIterator                  first,
+                                                  ForwardIterator                  last,
+                                                  ForwardIteratorR                 result,
+                                                  T                                init,
+                                                  BinaryOp                         op,
+                                                  iterator_diff_t<ForwardIterator> cutoff = {1}) {
+    return iro_context::with_checkout_cancel([&]() {
+      return impl::parallel_exclusive_scan(first, last, result, init, op,
+                                           resolve_cutoff<P, ForwardIterator>(cutoff));
+    });
+  }
+
+  // Returns the first iterator in [first, last) satisfying pred, or last if not found.
+  // Subranges after an already found element are neither spawned nor checked out.
+  template <typename ForwardIterator, typename Predicate>
+  static ForwardIterator parallel_find_if(ForwardIterator                  first,
+                                          ForwardIterator                  last,
+                                          Predicate                        pred,
+                                          iterator_diff_t<ForwardIterator> cutoff = {1}) {
+    return iro_context::with_checkout_cancel([&]() {
+      return impl::parallel_find_if(first, last, pred, resolve_cutoff<P, ForwardIterator>(cutoff));
+    });
+  }
+
+  template <typename ForwardIterator, typename Predicate>
+  static bool parallel_any_of(ForwardIterator                  first,
+                              ForwardIterator                  last,
+                              Predicate                        pred,
+                              iterator_diff_t<ForwardIterator> cutoff = {1}) {
+    return parallel_find_if(first, last, pred, cutoff) != last;
+  }
+
+  template <typename ForwardIterator, typename Predicate>
+  static bool parallel_all_of(ForwardIterator                  first,
+                              ForwardIterator                  last,
+                              Predicate                        pred,
+                              iterator_diff_t<ForwardIterator> cutoff = {1}) {
+    return parallel_find_if(first, last, [=](const auto& v) { return !pred(v); }, cutoff) == last;
+  }
+
+  // Copy the elements satisfying pred to result, preserving their order.
+  // Returns the end of the output range.
+  template <typename ForwardIterator, typename ForwardIteratorR, typename Predicate>
+  static ForwardIteratorR parallel_filter(ForwardIterator                  first,
+                                          ForwardIterator                  last,
+                                          ForwardIteratorR                 result,
+                                          Predicate                        pred,
+                                          iterator_diff_t<ForwardIterator> cutoff = {1}) {
+    return iro_context::with_checkout_cancel([&]() {
+      auto n = filter_two_pass<P, impl, false>(first, last, result, pred,
+                                               resolve_cutoff<P, ForwardIterator>(cutoff));
+      return std::next(result, n);
+    });
+  }
+
+  // Copy the elements satisfying pred to the beginning of result and the others after them,
+  // preserving the relative order in both groups. Returns the partition point in result.
+  template <typename ForwardIterator, typename ForwardIteratorR, typename Predicate>
+  static ForwardIteratorR parallel_partition(ForwardIterator                  first,
+                                             ForwardIterator                  last,
+                                             ForwardIteratorR                 result,
+                                             Predicate                        pred,
+                                             iterator_diff_t<ForwardIterator> cutoff = {1}) {
+    return iro_context::with_checkout_cancel([&]() {
+      auto n = filter_two_pass<P, impl, true>(first, last, result, pred,
+                                              resolve_cutoff<P, ForwardIterator>(cutoff));
+      return std::next(result, n);
+    });
+  }
 };
 
 template <typename P>
@@ -353,19 +975,20 @@ class ito_pattern_serial {
   using iro = typename P::iro;
   using access_mode = typename iro::access_mode;
 
-  struct parallel_invoke_inner_state {
+  struct parallel_invoke_inner_state : public parallel_invoke_parser<parallel_invoke_inner_state> {
+    using parallel_invoke_parser<parallel_invoke_inner_state>::parallel_invoke;
+    using empty = typename parallel_invoke_parser<parallel_invoke_inner_state>::empty;
+
     template <typename RetVal, typename Fn, typename ArgsTuple, typename... Rest>
     auto parallel_invoke_impl(Fn&& f, ArgsTuple&& args, Rest&&... r) {
       if constexpr (std::is_void_v<RetVal>) {
-        std::apply(f, args);
+        std::apply(std::forward<Fn>(f), std::forward<ArgsTuple>(args));
         return std::tuple_cat(std::make_tuple(empty{}), parallel_invoke(std::forward<Rest>(r)...));
       } else {
-        auto&& ret = std::apply(f, args);
-        return std::tuple_cat(std::make_tuple(ret), parallel_invoke(std::forward<Rest>(r)...));
+        auto&& ret = std::apply(std::forward<Fn>(f), std::forward<ArgsTuple>(args));
+        return std::tuple_cat(std::make_tuple(std::forward<decltype(ret)>(ret)), parallel_invoke(std::forward<Rest>(r)...));
       }
     }
-
-    ITYR_PARALLEL_INVOKE_DEF(8, parallel_invoke_impl)
   };
 
 public:
@@ -385,17 +1008,21 @@ public:
                            ForwardIterator                  last,
                            Fn                               f,
                            iterator_diff_t<ForwardIterator> cutoff) {
+    cutoff = resolve_cutoff<P, ForwardIterator>(cutoff);
+
     for_each_serial<P, Mode>(first, last, f, cutoff);
   }
 
-  template <access_mode Mode1, access_mode Mode2,
-            typename ForwardIterator1, typename ForwardIterator2, typename Fn>
+  template <access_mode... Modes,
+            typename ForwardIterator1, typename... ForwardIterators, typename Fn>
   static void parallel_for(ForwardIterator1                  first1,
                            ForwardIterator1                  last1,
-                           ForwardIterator2                  first2,
+                           std::tuple<ForwardIterators...>   firsts,
                            Fn                                f,
                            iterator_diff_t<ForwardIterator1> cutoff) {
-    for_each_serial<P, Mode1, Mode2>(first1, last1, first2, f, cutoff);
+    cutoff = resolve_cutoff<P, ForwardIterator1>(cutoff);
+
+    for_each_serial_n<P, Modes...>(first1, last1, firsts, f, cutoff);
   }
 
   template <typename ForwardIterator, typename T, typename ReduceOp, typename TransformOp>
@@ -405,6 +1032,8 @@ public:
                            ReduceOp                         reduce,
                            TransformOp                      transform,
                            iterator_diff_t<ForwardIterator> cutoff) {
+    cutoff = resolve_cutoff<P, ForwardIterator>(cutoff);
+
     T acc = init;
     for_each_serial<P, access_mode::read>(first, last, [&](const auto& v) {
       acc = reduce(acc, transform(v));
@@ -412,12 +1041,30 @@ public:
     return acc;
   }
 
+  template <typename ForwardIterator, typename IdentityFn, typename AccumulateOp, typename ReduceOp>
+  static auto parallel_reduce_inplace(ForwardIterator                  first,
+                                      ForwardIterator                  last,
+                                      IdentityFn                       identity,
+                                      AccumulateOp                     accumulate,
+                                      ReduceOp                         reduce [[maybe_unused]],
+                                      iterator_diff_t<ForwardIterator> cutoff) {
+    cutoff = resolve_cutoff<P, ForwardIterator>(cutoff);
+
+    auto acc = identity();
+    for_each_serial<P, access_mode::read>(first, last, [&](const auto& v) {
+      accumulate(acc, v);
+    }, cutoff);
+    return acc;
+  }
+
   template <typename ForwardIterator, typename ForwardIteratorR, class UnaryOp>
   static ForwardIteratorR parallel_transform(ForwardIterator                  first,
                                              ForwardIterator                  last,
                                              ForwardIteratorR                 result,
                                              UnaryOp                          unary_op,
                                              iterator_diff_t<ForwardIterator> cutoff) {
+    cutoff = resolve_cutoff<P, ForwardIterator>(cutoff);
+
     for_each_serial<P, access_mode::read, access_mode::write>(
         first, last, result, [&](const auto& v, auto&& r) {
       r = unary_op(v);
@@ -433,6 +1080,8 @@ public:
                                              ForwardIteratorR                  result,
                                              BinaryOp                          binary_op,
                                              iterator_diff_t<ForwardIterator1> cutoff) {
+    cutoff = resolve_cutoff<P, ForwardIterator1>(cutoff);
+
     for_each_serial<P, access_mode::read, access_mode::read, access_mode::write>(
         first1, last1, first2, result, [&](const auto& v1, const auto& v2, auto&& r) {
       r = binary_op(v1, v2);
@@ -441,6 +1090,40 @@ public:
     return std::next(result, d);
   }
 
+  template <typename ForwardIterator, typename ForwardIteratorR, typename BinaryOp, typename T>
+  static ForwardIteratorR parallel_inclusive_scan(ForwardIterator                  first,
+                                                  ForwardIterator                  last,
+                                                  ForwardIteratorR                 result,
+                                                  BinaryOp                         op,
+                                                  std::optional<T>                 init,
+                                                  iterator_diff_t<ForwardIterator> cutoff) {
+    scan_serial<P, true>(first, last, result, init, op, cutoff);
+    auto d = std::distance(first, last);
+    return std::next(result, d);
+  }
+
+  template <typename ForwardIterator, typename ForwardIteratorR, typename T, typename BinaryOp>
+  static ForwardIteratorR parallel_exclusive_scan(ForwardIterator                  first,
+                                                  ForwardIterator                  last,
+                                                  ForwardIteratorR                 result,
+                                                  T                                init,
+                                                  BinaryOp                         op,
+                                                  iterator_diff_t<ForwardIterator> cutoff) {
+    scan_serial<P, false>(first, last, result, std::optional<T>(init), op, cutoff);
+    auto d = std::distance(first, last);
+    return std::next(result, d);
+  }
+
+  template <typename ForwardIterator, typename Predicate>
+  static ForwardIterator parallel_find_if(ForwardIterator                  first,
+                                          ForwardIterator                  last,
+                                          Predicate                        pred,
+                                          iterator_diff_t<ForwardIterator> cutoff) {
+    auto d = std::distance(first, last);
+    auto i = find_if_serial<P>(first, last, 0, d, pred, cutoff, [](auto) { return false; });
+    return std::next(first, i);
+  }
+
 };
 
 template <typename P>
@@ -448,49 +1131,86 @@ class ito_pattern_naive {
   using iro = typename P::iro;
   using access_mode = typename iro::access_mode;
 
-  struct parallel_invoke_inner_state {
+  struct parallel_invoke_inner_state : public parallel_invoke_parser<parallel_invoke_inner_state> {
+    using parallel_invoke_parser<parallel_invoke_inner_state>::parallel_invoke;
+    using empty = typename parallel_invoke_parser<parallel_invoke_inner_state>::empty;
+
     template <typename RetVal, typename Fn, typename ArgsTuple>
     auto parallel_invoke_impl(Fn&& f, ArgsTuple&& args) {
       if constexpr (std::is_void_v<RetVal>) {
         iro::acquire();
-        std::apply(f, args);
+        std::apply(std::forward<Fn>(f), std::forward<ArgsTuple>(args));
         iro::release();
         return std::make_tuple(empty{});
       } else {
         iro::acquire();
-        auto&& r = std::apply(f, args);
+        auto&& r = std::apply(std::forward<Fn>(f), std::forward<ArgsTuple>(args));
         iro::release();
-        return std::make_tuple(r);
+        return std::make_tuple(std::forward<decltype(r)>(r));
       }
     };
 
     template <typename RetVal, typename Fn, typename ArgsTuple, typename... Rest>
     auto parallel_invoke_impl(Fn&& f, ArgsTuple&& args, Rest&&... r) {
       if constexpr (std::is_void_v<RetVal>) {
-        madm::uth::thread<void> th{[=] {
+        madm::uth::thread<void> th{[f = std::forward<Fn>(f), args = std::forward<ArgsTuple>(args)]() mutable {
           iro::acquire();
-          std::apply(f, args);
+          std::apply(std::move(f), std::move(args));
           iro::release();
         }};
-        auto&& ret_rest = parallel_invoke(std::forward<Rest>(r)...);
+        auto ret_rest = parallel_invoke(std::forward<Rest>(r)...);
         th.join();
-        return std::tuple_cat(std::make_tuple(empty{}), ret_rest);
+        return std::tuple_cat(std::make_tuple(empty{}), std::move(ret_rest));
       } else {
-        madm::uth::thread<RetVal> th{[=] {
+        madm::uth::thread<RetVal> th{[f = std::forward<Fn>(f), args = std::forward<ArgsTuple>(args)]() mutable {
           iro::acquire();
-          auto&& r = std::apply(f, args);
+          auto&& r = std::apply(std::move(f), std::move(args));
           iro::release();
-          return r;
+          return std::forward<decltype(r)>(r);
         }};
-        auto&& ret_rest = parallel_invoke(std::forward<Rest>(r)...);
+        auto ret_rest = parallel_invoke(std::forward<Rest>(r)...);
         auto&& ret = th.join();
-        return std::tuple_cat(std::make_tuple(ret), ret_rest);
+        return std::tuple_cat(std::make_tuple(std::forward<decltype(ret)>(ret)), std::move(ret_rest));
       }
     };
-
-    ITYR_PARALLEL_INVOKE_DEF(8, parallel_invoke_impl)
   };
 
+  template <typename ForwardIterator, typename Predicate>
+  static iterator_diff_t<ForwardIterator>
+  parallel_find_if_impl(ForwardIterator                                 first,
+                        ForwardIterator                                 last,
+                        iterator_diff_t<ForwardIterator>                offset,
+                        Predicate                                       pred,
+                        iterator_diff_t<ForwardIterator>                cutoff,
+                        find_index<P, iterator_diff_t<ForwardIterator>> found) {
+    auto d = std::distance(first, last);
+    if (d <= cutoff) {
+      auto i = find_if_serial<P>(first, last, offset, found.none(), pred, cutoff,
+                                 [&](auto j) { return found.get() <= j; });
+      found.update(i);
+      return i;
+    } else {
+      auto mid = std::next(first, d / 2);
+
+      iro::release();
+      auto th = madm::uth::thread<iterator_diff_t<ForwardIterator>>{[=] {
+        iro::acquire();
+        auto ret = parallel_find_if_impl(first, mid, offset, pred, cutoff, found);
+        iro::release();
+        return ret;
+      }};
+      iro::acquire();
+
+      auto i2 = parallel_find_if_impl(mid, last, offset + d / 2, pred, cutoff, found);
+
+      iro::release();
+      auto i1 = th.join();
+      iro::acquire();
+
+      return std::min(i1, i2);
+    }
+  }
+
 public:
   template <typename Fn, typename... Args>
   static auto root_spawn(Fn&& f, Args&&... args) {
@@ -503,7 +1223,7 @@ public:
       th.join();
       iro::acquire();
     } else {
-      auto&& ret = th.join();
+      ret_t ret = th.join();
       iro::acquire();
       return ret;
     }
@@ -523,6 +1243,8 @@ public:
                            ForwardIterator                  last,
                            Fn                               f,
                            iterator_diff_t<ForwardIterator> cutoff) {
+    cutoff = resolve_cutoff<P, ForwardIterator>(cutoff);
+
     auto d = std::distance(first, last);
     if (d <= cutoff) {
       for_each_serial<P, Mode>(first, last, f, cutoff);
@@ -545,29 +1267,31 @@ public:
     }
   }
 
-  template <access_mode Mode1, access_mode Mode2,
-            typename ForwardIterator1, typename ForwardIterator2, typename Fn>
+  template <access_mode... Modes,
+            typename ForwardIterator1, typename... ForwardIterators, typename Fn>
   static void parallel_for(ForwardIterator1                  first1,
                            ForwardIterator1                  last1,
-                           ForwardIterator2                  first2,
+                           std::tuple<ForwardIterators...>   firsts,
                            Fn                                f,
                            iterator_diff_t<ForwardIterator1> cutoff) {
+    cutoff = resolve_cutoff<P, ForwardIterator1>(cutoff);
+
     auto d = std::distance(first1, last1);
     if (d <= cutoff) {
-      for_each_serial<P, Mode1, Mode2>(first1, last1, first2, f, cutoff);
+      for_each_serial_n<P, Modes...>(first1, last1, firsts, f, cutoff);
     } else {
       auto mid1 = std::next(first1, d / 2);
 
       iro::release();
       auto th = madm::uth::thread<void>{[=] {
         iro::acquire();
-        parallel_for<Mode1, Mode2>(first1, mid1, first2, f, cutoff);
+        parallel_for<Modes...>(first1, mid1, firsts, f, cutoff);
         iro::release();
       }};
       iro::acquire();
 
-      auto mid2 = std::next(first2, d / 2);
-      parallel_for<Mode1, Mode2>(mid1, last1, mid2, f, cutoff);
+      auto mids = next_all(firsts, d / 2);
+      parallel_for<Modes...>(mid1, last1, mids, f, cutoff);
 
       iro::release();
       th.join();
@@ -582,6 +1306,8 @@ public:
                            ReduceOp                         reduce,
                            TransformOp                      transform,
                            iterator_diff_t<ForwardIterator> cutoff) {
+    cutoff = resolve_cutoff<P, ForwardIterator>(cutoff);
+
     auto d = std::distance(first, last);
     if (d <= cutoff) {
       T acc = init;
@@ -611,12 +1337,63 @@ public:
     }
   }
 
+  template <typename ForwardIterator, typename T, typename IdentityFn, typename AccumulateOp, typename ReduceOp>
+  static T parallel_reduce_inplace_impl(ForwardIterator                  first,
+                                        ForwardIterator                  last,
+                                        T                                acc,
+                                        IdentityFn                       identity,
+                                        AccumulateOp                     accumulate,
+                                        ReduceOp                         reduce,
+                                        iterator_diff_t<ForwardIterator> cutoff) {
+    auto d = std::distance(first, last);
+    if (d <= cutoff) {
+      for_each_serial<P, access_mode::read>(first, last, [&](const auto& v) {
+        accumulate(acc, v);
+      }, cutoff);
+      return acc;
+    } else {
+      auto mid = std::next(first, d / 2);
+
+      iro::release();
+      auto th = madm::uth::thread<T>{[=, acc = std::move(acc)]() mutable {
+        iro::acquire();
+        T ret = parallel_reduce_inplace_impl(first, mid, std::move(acc), identity, accumulate, reduce, cutoff);
+        iro::release();
+        return ret;
+      }};
+      iro::acquire();
+
+      T acc2 = parallel_reduce_inplace_impl(mid, last, identity(), identity, accumulate, reduce, cutoff);
+
+      iro::release();
+      T acc1 = th.join();
+      iro::acquire();
+
+      reduce(acc1, std::as_const(acc2));
+      return acc1;
+    }
+  }
+
+  template <typename ForwardIterator, typename IdentityFn, typename AccumulateOp, typename ReduceOp>
+  static auto parallel_reduce_inplace(ForwardIterator                  first,
+                                      ForwardIterator                  last,
+                                      IdentityFn                       identity,
+                                      AccumulateOp                     accumulate,
+                                      ReduceOp                         reduce,
+                                      iterator_diff_t<ForwardIterator> cutoff) {
+    cutoff = resolve_cutoff<P, ForwardIterator>(cutoff);
+
+    return parallel_reduce_inplace_impl(first, last, identity(), identity, accumulate, reduce, cutoff);
+  }
+
   template <typename ForwardIterator, typename ForwardIteratorR, class UnaryOp>
   static ForwardIteratorR parallel_transform(ForwardIterator                  first,
                                              ForwardIterator                  last,
                                              ForwardIteratorR                 result,
                                              UnaryOp                          unary_op,
                                              iterator_diff_t<ForwardIterator> cutoff) {
+    cutoff = resolve_cutoff<P, ForwardIterator>(cutoff);
+
     auto d = std::distance(first, last);
     if (d <= cutoff) {
       for_each_serial<P, access_mode::read, access_mode::write>(
@@ -651,6 +1428,8 @@ public:
                                              ForwardIteratorR                  result,
                                              BinaryOp                          binary_op,
                                              iterator_diff_t<ForwardIterator1> cutoff) {
+    cutoff = resolve_cutoff<P, ForwardIterator1>(cutoff);
+
     auto d = std::distance(first1, last1);
     if (d <= cutoff) {
       for_each_serial<P, access_mode::read, access_mode::read, access_mode::write>(
@@ -679,6 +1458,42 @@ public:
     return std::next(result, d);
   }
 
+  template <typename ForwardIterator, typename ForwardIteratorR, typename BinaryOp, typename T>
+  static ForwardIteratorR parallel_inclusive_scan(ForwardIterator                  first,
+                                                  ForwardIterator                  last,
+                                                  ForwardIteratorR                 result,
+                                                  BinaryOp                         op,
+                                                  std::optional<T>                 init,
+                                                  iterator_diff_t<ForwardIterator> cutoff) {
+    scan_two_pass<P, ito_pattern_naive, true>(first, last, result, init, op, cutoff);
+    auto d = std::distance(first, last);
+    return std::next(result, d);
+  }
+
+  template <typename ForwardIterator, typename ForwardIteratorR, typename T, typename BinaryOp>
+  static ForwardIteratorR parallel_exclusive_scan(ForwardIterator                  first,
+                                                  ForwardIterator                  last,
+                                                  ForwardIteratorR                 result,
+                                                  T                                init,
+                                                  BinaryOp                         op,
+                                                  iterator_diff_t<ForwardIterator> cutoff) {
+    scan_two_pass<P, ito_pattern_naive, false>(first, last, result, std::optional<T>(init), op, cutoff);
+    auto d = std::distance(first, last);
+    return std::next(result, d);
+  }
+
+  template <typename ForwardIterator, typename Predicate>
+  static ForwardIterator parallel_find_if(ForwardIterator                  first,
+                                          ForwardIterator                  last,
+                                          Predicate                        pred,
+                                          iterator_diff_t<ForwardIterator> cutoff) {
+    auto d = std::distance(first, last);
+    find_index<P, iterator_diff_t<ForwardIterator>> found(d);
+    auto i = parallel_find_if_impl(first, last, 0, pred, cutoff, found);
+    found.destroy();
+    return std::next(first, i);
+  }
+
 };
 
 template <typename P>
@@ -686,7 +1501,10 @@ class ito_pattern_workfirst {
   using iro = typename P::iro;
   using access_mode = typename iro::access_mode;
 
-  struct parallel_invoke_inner_state {
+  struct parallel_invoke_inner_state : public parallel_invoke_parser<parallel_invoke_inner_state> {
+    using parallel_invoke_parser<parallel_invoke_inner_state>::parallel_invoke;
+    using empty = typename parallel_invoke_parser<parallel_invoke_inner_state>::empty;
+
     bool all_synched = true;
     bool blocked = false;
 
@@ -694,11 +1512,11 @@ class ito_pattern_workfirst {
     auto parallel_invoke_impl(Fn&& f, ArgsTuple&& args) {
       iro::poll();
       if constexpr (std::is_void_v<RetVal>) {
-        std::apply(f, args);
+        std::apply(std::forward<Fn>(f), std::forward<ArgsTuple>(args));
         return std::make_tuple(empty{});
       } else {
-        auto&& r = std::apply(f, args);
-        return std::make_tuple(r);
+        auto&& r = std::apply(std::forward<Fn>(f), std::forward<ArgsTuple>(args));
+        return std::make_tuple(std::forward<decltype(r)>(r));
       }
     };
 
@@ -707,7 +1525,7 @@ class ito_pattern_workfirst {
       iro::poll();
 
       auto th = madm::uth::thread<RetVal>{};
-      bool synched = th.spawn_aux(f, args,
+      bool synched = th.spawn_aux(std::forward<Fn>(f), std::forward<ArgsTuple>(args),
         [=] (bool parent_popped) {
           // on-die callback
           if (!parent_popped) {
@@ -720,7 +1538,7 @@ class ito_pattern_workfirst {
       }
       all_synched &= synched;
 
-      auto&& ret_rest = parallel_invoke(std::forward<Rest>(r)...);
+      auto ret_rest = parallel_invoke(std::forward<Rest>(r)...);
 
       iro::poll();
 
@@ -732,7 +1550,7 @@ class ito_pattern_workfirst {
             blocked = true;
           }
         });
-        return std::tuple_cat(std::make_tuple(empty{}), ret_rest);
+        return std::tuple_cat(std::make_tuple(empty{}), std::move(ret_rest));
       } else {
         auto&& ret = th.join_aux(0, [&] {
           // on-block callback
@@ -741,31 +1559,30 @@ class ito_pattern_workfirst {
             blocked = true;
           }
         });
-        return std::tuple_cat(std::make_tuple(ret), ret_rest);
+        return std::tuple_cat(std::make_tuple(std::forward<decltype(ret)>(ret)), std::move(ret_rest));
       }
     };
-
-    ITYR_PARALLEL_INVOKE_DEF(8, parallel_invoke_impl)
   };
 
   template <access_mode Mode, typename ForwardIterator, typename Fn>
-  static bool parallel_for_impl(ForwardIterator                  first,
-                                ForwardIterator                  last,
-                                Fn                               f,
-                                iterator_diff_t<ForwardIterator> cutoff) {
+  static bool parallel_for_impl(ForwardIterator                            first,
+                                ForwardIterator                            last,
+                                Fn                                         f,
+                                splitter<iterator_diff_t<ForwardIterator>> sp) {
     iro::poll();
 
     auto d = std::distance(first, last);
-    if (d <= cutoff) {
-      for_each_serial<P, Mode>(first, last, f, cutoff);
+    if (!sp.should_split(d)) {
+      for_each_serial<P, Mode>(first, last, f, sp.grain);
       return true;
     } else {
-      auto mid = std::next(first, d / 2);
+      auto d1 = sp.mid(first, d);
+      auto mid = std::next(first, d1);
 
       auto th = madm::uth::thread<void>{};
       bool synched = th.spawn_aux(
         parallel_for_impl<Mode, ForwardIterator, Fn>,
-        std::make_tuple(first, mid, std::forward<Fn>(f), cutoff),
+        std::make_tuple(first, mid, std::forward<Fn>(f), sp.split(false)),
         [=] (bool parent_popped) {
           // on-die callback
           if (!parent_popped) {
@@ -777,7 +1594,7 @@ class ito_pattern_workfirst {
         iro::acquire();
       }
 
-      synched &= parallel_for_impl<Mode>(mid, last, std::forward<Fn>(f), cutoff);
+      synched &= parallel_for_impl<Mode>(mid, last, std::forward<Fn>(f), sp.split(!synched));
 
       th.join_aux(0, [&] {
         // on-block callback
@@ -788,26 +1605,79 @@ class ito_pattern_workfirst {
     }
   }
 
-  template <access_mode Mode1, access_mode Mode2,
-            typename ForwardIterator1, typename ForwardIterator2, typename Fn>
-  static bool parallel_for_impl(ForwardIterator1                  first1,
-                                ForwardIterator1                  last1,
-                                ForwardIterator2                  first2,
-                                Fn                                f,
-                                iterator_diff_t<ForwardIterator1> cutoff) {
+  template <access_mode... Modes,
+            typename ForwardIterator1, typename... ForwardIterators, typename Fn>
+  static bool parallel_for_impl(ForwardIterator1                            first1,
+                                ForwardIterator1                            last1,
+                                std::tuple<ForwardIterators...>             firsts,
+                                Fn                                          f,
+                                splitter<iterator_diff_t<ForwardIterator1>> sp) {
     iro::poll();
 
     auto d = std::distance(first1, last1);
-    if (d <= cutoff) {
-      for_each_serial<P, Mode1, Mode2>(first1, last1, first2, f, cutoff);
+    if (!sp.should_split(d)) {
+      for_each_serial_n<P, Modes...>(first1, last1, firsts, f, sp.grain);
       return true;
     } else {
-      auto mid1 = std::next(first1, d / 2);
+      auto d1 = sp.mid(first1, d);
+      auto mid1 = std::next(first1, d1);
+
+      auto th = madm::uth::thread<void>{};
+      bool synched = th.spawn_aux(
+        [](auto... args) { return parallel_for_impl<Modes...>(args...); },
+        std::make_tuple(first1, mid1, firsts, f, sp.split(false)),
+        [=] (bool parent_popped) {
+          // on-die callback
+          if (!parent_popped) {
+            iro::release();
+          }
+        }
+      );
+      if (!synched) {
+        iro::acquire();
+      }
+
+      auto mids = next_all(firsts, d1);
+      synched &= parallel_for_impl<Modes...>(mid1, last1, mids, f, sp.split(!synched));
+
+      th.join_aux(0, [&] {
+        // on-block callback
+        iro::release();
+      });
+
+      return synched;
+    }
+  }
+
+  template <bool TopLevel, typename ForwardIterator, typename T, typename ReduceOp, typename TransformOp>
+  static std::conditional_t<TopLevel, std::tuple<T, bool>, T>
+  parallel_reduce_impl(ForwardIterator                            first,
+                       ForwardIterator                            last,
+                       T                                          init,
+                       ReduceOp                                   reduce,
+                       TransformOp                                transform,
+                       splitter<iterator_diff_t<ForwardIterator>> sp) {
+    iro::poll();
+
+    auto d = std::distance(first, last);
+    if (!sp.should_split(d)) {
+      T acc = init;
+      for_each_serial<P, access_mode::read>(first, last, [&](const auto& v) {
+        acc = reduce(acc, transform(v));
+      }, sp.grain);
+      if constexpr (TopLevel) {
+        return {acc, true};
+      } else {
+        return acc;
+      }
+    } else {
+      auto d1 = sp.mid(first, d);
+      auto mid = std::next(first, d1);
 
-      auto th = madm::uth::thread<void>{};
+      auto th = madm::uth::thread<T>{};
       bool synched = th.spawn_aux(
-        parallel_for_impl<Mode1, Mode2, ForwardIterator1, ForwardIterator2, Fn>,
-        std::make_tuple(first1, mid1, first2, f, cutoff),
+        parallel_reduce_impl<false, ForwardIterator, T, ReduceOp, TransformOp>,
+        std::make_tuple(first, mid, init, reduce, transform, sp.split(false)),
         [=] (bool parent_popped) {
           // on-die callback
           if (!parent_popped) {
@@ -819,46 +1689,56 @@ class ito_pattern_workfirst {
         iro::acquire();
       }
 
-      auto mid2 = std::next(first2, d / 2);
-      synched &= parallel_for_impl<Mode1, Mode2>(mid1, last1, mid2, f, cutoff);
+      auto ret2 = parallel_reduce_impl<TopLevel>(mid, last, init, reduce, transform, sp.split(!synched));
 
-      th.join_aux(0, [&] {
+      auto acc1 = th.join_aux(0, [&] {
         // on-block callback
         iro::release();
       });
 
-      return synched;
+      if constexpr (TopLevel) {
+        auto [acc2, synched2] = ret2;
+        return {reduce(acc1, acc2), synched & synched2};
+      } else {
+        T acc2 = ret2;
+        return reduce(acc1, acc2);
+      }
     }
   }
 
-  template <bool TopLevel, typename ForwardIterator, typename T, typename ReduceOp, typename TransformOp>
+  // The accumulator is moved into the spawned task. If the continuation is not stolen,
+  // the task has completed and its accumulator is reused for the rest of the range;
+  // otherwise the continuation starts from a new identity and the results are merged.
+  template <bool TopLevel, typename ForwardIterator, typename T,
+            typename IdentityFn, typename AccumulateOp, typename ReduceOp>
   static std::conditional_t<TopLevel, std::tuple<T, bool>, T>
-  parallel_reduce_impl(ForwardIterator                  first,
-                       ForwardIterator                  last,
-                       T                                init,
-                       ReduceOp                         reduce,
-                       TransformOp                      transform,
-                       iterator_diff_t<ForwardIterator> cutoff) {
+  parallel_reduce_inplace_impl(ForwardIterator                            first,
+                               ForwardIterator                            last,
+                               T                                          acc,
+                               IdentityFn                                 identity,
+                               AccumulateOp                               accumulate,
+                               ReduceOp                                   reduce,
+                               splitter<iterator_diff_t<ForwardIterator>> sp) {
     iro::poll();
 
     auto d = std::distance(first, last);
-    if (d <= cutoff) {
-      T acc = init;
+    if (!sp.should_split(d)) {
       for_each_serial<P, access_mode::read>(first, last, [&](const auto& v) {
-        acc = reduce(acc, transform(v));
-      }, cutoff);
+        accumulate(acc, v);
+      }, sp.grain);
       if constexpr (TopLevel) {
-        return {acc, true};
+        return {std::move(acc), true};
       } else {
         return acc;
       }
     } else {
-      auto mid = std::next(first, d / 2);
+      auto d1 = sp.mid(first, d);
+      auto mid = std::next(first, d1);
 
       auto th = madm::uth::thread<T>{};
       bool synched = th.spawn_aux(
-        parallel_reduce_impl<false, ForwardIterator, T, ReduceOp, TransformOp>,
-        std::make_tuple(first, mid, init, reduce, transform, cutoff),
+        parallel_reduce_inplace_impl<false, ForwardIterator, T, IdentityFn, AccumulateOp, ReduceOp>,
+        std::make_tuple(first, mid, std::move(acc), identity, accumulate, reduce, sp.split(false)),
         [=] (bool parent_popped) {
           // on-die callback
           if (!parent_popped) {
@@ -870,45 +1750,55 @@ class ito_pattern_workfirst {
         iro::acquire();
       }
 
-      auto ret2 = parallel_reduce_impl<TopLevel>(mid, last, init, reduce, transform, cutoff);
-
-      auto acc1 = th.join_aux(0, [&] {
+      auto on_block = [] {
         // on-block callback
         iro::release();
-      });
+      };
+
+      if (synched) {
+        T acc1 = th.join_aux(0, on_block);
+        return parallel_reduce_inplace_impl<TopLevel>(mid, last, std::move(acc1), identity, accumulate, reduce,
+                                                      sp.split(false));
+      }
+
+      auto ret2 = parallel_reduce_inplace_impl<TopLevel>(mid, last, identity(), identity, accumulate, reduce,
+                                                         sp.split(true));
+
+      T acc1 = th.join_aux(0, on_block);
 
       if constexpr (TopLevel) {
-        auto [acc2, synched2] = ret2;
-        return {reduce(acc1, acc2), synched & synched2};
+        reduce(acc1, std::as_const(std::get<0>(ret2)));
+        return {std::move(acc1), false};
       } else {
-        T acc2 = ret2;
-        return reduce(acc1, acc2);
+        reduce(acc1, std::as_const(ret2));
+        return acc1;
       }
     }
   }
 
   template <typename ForwardIterator, typename ForwardIteratorR, class UnaryOp>
-  static bool parallel_transform_impl(ForwardIterator                  first,
-                                      ForwardIterator                  last,
-                                      ForwardIteratorR                 result,
-                                      UnaryOp                          unary_op,
-                                      iterator_diff_t<ForwardIterator> cutoff) {
+  static bool parallel_transform_impl(ForwardIterator                            first,
+                                      ForwardIterator                            last,
+                                      ForwardIteratorR                           result,
+                                      UnaryOp                                    unary_op,
+                                      splitter<iterator_diff_t<ForwardIterator>> sp) {
     iro::poll();
 
     auto d = std::distance(first, last);
-    if (d <= cutoff) {
+    if (!sp.should_split(d)) {
       for_each_serial<P, access_mode::read, access_mode::write>(
           first, last, result, [&](const auto& v, auto&& r) {
         r = unary_op(v);
-      }, cutoff);
+      }, sp.grain);
       return true;
     } else {
-      auto mid = std::next(first, d / 2);
+      auto d1 = sp.mid(first, d);
+      auto mid = std::next(first, d1);
 
       auto th = madm::uth::thread<void>{};
       bool synched = th.spawn_aux(
         parallel_transform_impl<ForwardIterator, ForwardIteratorR, UnaryOp>,
-        std::make_tuple(first, mid, result, unary_op, cutoff),
+        std::make_tuple(first, mid, result, unary_op, sp.split(false)),
         [=] (bool parent_popped) {
           // on-die callback
           if (!parent_popped) {
@@ -920,8 +1810,8 @@ class ito_pattern_workfirst {
         iro::acquire();
       }
 
-      auto result_mid = std::next(result, d / 2);
-      synched &= parallel_transform_impl(mid, last, result_mid, unary_op, cutoff);
+      auto result_mid = std::next(result, d1);
+      synched &= parallel_transform_impl(mid, last, result_mid, unary_op, sp.split(!synched));
 
       th.join_aux(0, [&] {
         // on-block callback
@@ -933,28 +1823,29 @@ class ito_pattern_workfirst {
   }
 
   template <typename ForwardIterator1, typename ForwardIterator2, typename ForwardIteratorR, class BinaryOp>
-  static bool parallel_transform_impl(ForwardIterator1                  first1,
-                                      ForwardIterator1                  last1,
-                                      ForwardIterator2                  first2,
-                                      ForwardIteratorR                  result,
-                                      BinaryOp                          binary_op,
-                                      iterator_diff_t<ForwardIterator1> cutoff) {
+  static bool parallel_transform_impl(ForwardIterator1                            first1,
+                                      ForwardIterator1                            last1,
+                                      ForwardIterator2                            first2,
+                                      ForwardIteratorR                            result,
+                                      BinaryOp                                    binary_op,
+                                      splitter<iterator_diff_t<ForwardIterator1>> sp) {
     iro::poll();
 
     auto d = std::distance(first1, last1);
-    if (d <= cutoff) {
+    if (!sp.should_split(d)) {
       for_each_serial<P, access_mode::read, access_mode::read, access_mode::write>(
           first1, last1, first2, result, [&](const auto& v1, const auto& v2, auto&& r) {
         r = binary_op(v1, v2);
-      }, cutoff);
+      }, sp.grain);
       return true;
     } else {
-      auto mid1 = std::next(first1, d / 2);
+      auto d1 = sp.mid(first1, d);
+      auto mid1 = std::next(first1, d1);
 
       auto th = madm::uth::thread<void>{};
       bool synched = th.spawn_aux(
         parallel_transform_impl<ForwardIterator1, ForwardIterator2, ForwardIteratorR, BinaryOp>,
-        std::make_tuple(first1, mid1, first2, result, binary_op, cutoff),
+        std::make_tuple(first1, mid1, first2, result, binary_op, sp.split(false)),
         [=] (bool parent_popped) {
           // on-die callback
           if (!parent_popped) {
@@ -966,9 +1857,9 @@ class ito_pattern_workfirst {
         iro::acquire();
       }
 
-      auto mid2 = std::next(first2, d / 2);
-      auto result_mid = std::next(result, d / 2);
-      synched &= parallel_transform_impl(mid1, last1, mid2, result_mid, binary_op, cutoff);
+      auto mid2 = std::next(first2, d1);
+      auto result_mid = std::next(result, d1);
+      synched &= parallel_transform_impl(mid1, last1, mid2, result_mid, binary_op, sp.split(!synched));
 
       th.join_aux(0, [&] {
         // on-block callback
@@ -979,6 +1870,65 @@ class ito_pattern_workfirst {
     }
   }
 
+  template <bool TopLevel, typename ForwardIterator, typename Predicate>
+  static std::conditional_t<TopLevel,
+                            std::tuple<iterator_diff_t<ForwardIterator>, bool>,
+                            iterator_diff_t<ForwardIterator>>
+  parallel_find_if_impl(ForwardIterator                                 first,
+                        ForwardIterator                                 last,
+                        iterator_diff_t<ForwardIterator>                offset,
+                        Predicate                                       pred,
+                        iterator_diff_t<ForwardIterator>                cutoff,
+                        find_index<P, iterator_diff_t<ForwardIterator>> found,
+                        bool                                            stolen) {
+    iro::poll();
+
+    auto d = std::distance(first, last);
+    // The hint is read at leaves, and by continuations that were stolen and may have become
+    // useless while they were waiting; other internal nodes do not read it.
+    if (d <= cutoff || (stolen && found.get() <= offset)) {
+      auto i = find_if_serial<P>(first, last, offset, found.none(), pred, cutoff,
+                                 [&](auto j) { return found.get() <= j; });
+      found.update(i);
+      if constexpr (TopLevel) {
+        return {i, true};
+      } else {
+        return i;
+      }
+    } else {
+      auto mid = std::next(first, d / 2);
+
+      auto th = madm::uth::thread<iterator_diff_t<ForwardIterator>>{};
+      bool synched = th.spawn_aux(
+        parallel_find_if_impl<false, ForwardIterator, Predicate>,
+        std::make_tuple(first, mid, offset, pred, cutoff, found, false),
+        [=] (bool parent_popped) {
+          // on-die callback
+          if (!parent_popped) {
+            iro::release();
+          }
+        }
+      );
+      if (!synched) {
+        iro::acquire();
+      }
+
+      auto ret2 = parallel_find_if_impl<TopLevel>(mid, last, offset + d / 2, pred, cutoff, found, !synched);
+
+      auto i1 = th.join_aux(0, [&] {
+        // on-block callback
+        iro::release();
+      });
+
+      if constexpr (TopLevel) {
+        auto [i2, synched2] = ret2;
+        return {std::min(i1, i2), synched & synched2};
+      } else {
+        return std::min(i1, ret2);
+      }
+    }
+  }
+
 public:
   template <typename Fn, typename... Args>
   static auto root_spawn(Fn&& f, Args&&... args) {
@@ -991,7 +1941,7 @@ public:
       th.join();
       iro::acquire();
     } else {
-      auto&& ret = th.join();
+      ret_t ret = th.join();
       iro::acquire();
       return ret;
     }
@@ -1021,7 +1971,7 @@ public:
     iro::poll();
 
     iro::release();
-    bool synched = parallel_for_impl<Mode>(first, last, f, cutoff);
+    bool synched = parallel_for_impl<Mode>(first, last, f, make_splitter<P, ForwardIterator>(cutoff));
     if (!synched) {
       iro::acquire();
     }
@@ -1029,17 +1979,17 @@ public:
     iro::poll();
   }
 
-  template <access_mode Mode1, access_mode Mode2,
-            typename ForwardIterator1, typename ForwardIterator2, typename Fn>
+  template <access_mode... Modes,
+            typename ForwardIterator1, typename... ForwardIterators, typename Fn>
   static void parallel_for(ForwardIterator1                  first1,
                            ForwardIterator1                  last1,
-                           ForwardIterator2                  first2,
+                           std::tuple<ForwardIterators...>   firsts,
                            Fn                                f,
                            iterator_diff_t<ForwardIterator1> cutoff) {
     iro::poll();
 
     iro::release();
-    bool synched = parallel_for_impl<Mode1, Mode2>(first1, last1, first2, f, cutoff);
+    bool synched = parallel_for_impl<Modes...>(first1, last1, firsts, f, make_splitter<P, ForwardIterator1>(cutoff));
     if (!synched) {
       iro::acquire();
     }
@@ -1057,7 +2007,7 @@ public:
     iro::poll();
 
     iro::release();
-    auto [ret, synched] = parallel_reduce_impl<true>(first, last, init, reduce, transform, cutoff);
+    auto [ret, synched] = parallel_reduce_impl<true>(first, last, init, reduce, transform, make_splitter<P, ForwardIterator>(cutoff));
     if (!synched) {
       iro::acquire();
     }
@@ -1067,6 +2017,27 @@ public:
     return ret;
   }
 
+  template <typename ForwardIterator, typename IdentityFn, typename AccumulateOp, typename ReduceOp>
+  static auto parallel_reduce_inplace(ForwardIterator                  first,
+                                      ForwardIterator                  last,
+                                      IdentityFn                       identity,
+                                      AccumulateOp                     accumulate,
+                                      ReduceOp                         reduce,
+                                      iterator_diff_t<ForwardIterator> cutoff) {
+    iro::poll();
+
+    iro::release();
+    auto [ret, synched] = parallel_reduce_inplace_impl<true>(first, last, identity(), identity, accumulate, reduce,
+                                                             make_splitter<P, ForwardIterator>(cutoff));
+    if (!synched) {
+      iro::acquire();
+    }
+
+    iro::poll();
+
+    return std::move(ret);
+  }
+
   template <typename ForwardIterator, typename ForwardIteratorR, class UnaryOp>
   static ForwardIteratorR parallel_transform(ForwardIterator                  first,
                                              ForwardIterator                  last,
@@ -1076,7 +2047,7 @@ public:
     iro::poll();
 
     iro::release();
-    bool synched = parallel_transform_impl(first, last, result, unary_op, cutoff);
+    bool synched = parallel_transform_impl(first, last, result, unary_op, make_splitter<P, ForwardIterator>(cutoff));
     if (!synched) {
       iro::acquire();
     }
@@ -1097,7 +2068,7 @@ public:
     iro::poll();
 
     iro::release();
-    bool synched = parallel_transform_impl(first1, last1, first2, result, binary_op, cutoff);
+    bool synched = parallel_transform_impl(first1, last1, first2, result, binary_op, make_splitter<P, ForwardIterator1>(cutoff));
     if (!synched) {
       iro::acquire();
     }
@@ -1108,6 +2079,53 @@ public:
     return std::next(result, d);
   }
 
+  template <typename ForwardIterator, typename ForwardIteratorR, typename BinaryOp, typename T>
+  static ForwardIteratorR parallel_inclusive_scan(ForwardIterator                  first,
+                                                  ForwardIterator                  last,
+                                                  ForwardIteratorR                 result,
+                                                  BinaryOp                         op,
+                                                  std::optional<T>                 init,
+                                                  iterator_diff_t<ForwardIterator> cutoff) {
+    scan_two_pass<P, ito_pattern_workfirst, true>(first, last, result, init, op, cutoff);
+    auto d = std::distance(first, last);
+    return std::next(result, d);
+  }
+
+  template <typename ForwardIterator, typename ForwardIteratorR, typename T, typename BinaryOp>
+  static ForwardIteratorR parallel_exclusive_scan(ForwardIterator                  first,
+                                                  ForwardIterator                  last,
+                                                  ForwardIteratorR                 result,
+                                                  T                                init,
+                                                  BinaryOp                         op,
+                                                  iterator_diff_t<ForwardIterator> cutoff) {
+    scan_two_pass<P, ito_pattern_workfirst, false>(first, last, result, std::optional<T>(init), op, cutoff);
+    auto d = std::distance(first, last);
+    return std::next(result, d);
+  }
+
+  template <typename ForwardIterator, typename Predicate>
+  static ForwardIterator parallel_find_if(ForwardIterator                  first,
+                                          ForwardIterator                  last,
+                                          Predicate                        pred,
+                                          iterator_diff_t<ForwardIterator> cutoff) {
+    iro::poll();
+
+    auto d = std::distance(first, last);
+    find_index<P, iterator_diff_t<ForwardIterator>> found(d);
+
+    iro::release();
+    auto [i, synched] = parallel_find_if_impl<true>(first, last, 0, pred, cutoff, found, false);
+    if (!synched) {
+      iro::acquire();
+    }
+
+    found.destroy();
+
+    iro::poll();
+
+    return std::next(first, i);
+  }
+
 };
 
 template <typename P>
@@ -1115,7 +2133,10 @@ class ito_pattern_workfirst_lazy {
   using iro = typename P::iro;
   using access_mode = typename iro::access_mode;
 
-  struct parallel_invoke_inner_state {
+  struct parallel_invoke_inner_state : public parallel_invoke_parser<parallel_invoke_inner_state> {
+    using parallel_invoke_parser<parallel_invoke_inner_state>::parallel_invoke;
+    using empty = typename parallel_invoke_parser<parallel_invoke_inner_state>::empty;
+
     typename iro::release_handler rh;
     bool all_synched = true;
     bool blocked = false;
@@ -1124,11 +2145,11 @@ class ito_pattern_workfirst_lazy {
     auto parallel_invoke_impl(Fn&& f, ArgsTuple&& args) {
       iro::poll();
       if constexpr (std::is_void_v<RetVal>) {
-        std::apply(f, args);
+        std::apply(std::forward<Fn>(f), std::forward<ArgsTuple>(args));
         return std::make_tuple(empty{});
       } else {
-        auto&& r = std::apply(f, args);
-        return std::make_tuple(r);
+        auto&& r = std::apply(std::forward<Fn>(f), std::forward<ArgsTuple>(args));
+        return std::make_tuple(std::forward<decltype(r)>(r));
       }
     };
 
@@ -1139,7 +2160,7 @@ class ito_pattern_workfirst_lazy {
       iro::whitelist_new();
 
       auto th = madm::uth::thread<RetVal>{};
-      bool synched = th.spawn_aux(f, args,
+      bool synched = th.spawn_aux(std::forward<Fn>(f), std::forward<ArgsTuple>(args),
         [=] (bool parent_popped) {
           // on-die callback
           if (parent_popped) {
@@ -1155,7 +2176,7 @@ class ito_pattern_workfirst_lazy {
       }
       all_synched &= synched;
 
-      auto&& ret_rest = parallel_invoke(std::forward<Rest>(r)...);
+      auto ret_rest = parallel_invoke(std::forward<Rest>(r)...);
 
       iro::poll();
 
@@ -1167,7 +2188,7 @@ class ito_pattern_workfirst_lazy {
             blocked = true;
           }
         });
-        return std::tuple_cat(std::make_tuple(empty{}), ret_rest);
+        return std::tuple_cat(std::make_tuple(empty{}), std::move(ret_rest));
       } else {
         auto&& ret = th.join_aux(0, [&] {
           // on-block callback
@@ -1176,34 +2197,33 @@ class ito_pattern_workfirst_lazy {
             blocked = true;
           }
         });
-        return std::tuple_cat(std::make_tuple(ret), ret_rest);
+        return std::tuple_cat(std::make_tuple(std::forward<decltype(ret)>(ret)), std::move(ret_rest));
       }
     };
-
-    ITYR_PARALLEL_INVOKE_DEF(8, parallel_invoke_impl)
   };
 
   template <access_mode Mode, typename ForwardIterator, typename Fn>
-  static bool parallel_for_impl(ForwardIterator                  first,
-                                ForwardIterator                  last,
-                                Fn                               f,
-                                iterator_diff_t<ForwardIterator> cutoff,
-                                typename iro::release_handler    rh) {
+  static bool parallel_for_impl(ForwardIterator                            first,
+                                ForwardIterator                            last,
+                                Fn                                         f,
+                                splitter<iterator_diff_t<ForwardIterator>> sp,
+                                typename iro::release_handler              rh) {
     iro::poll();
 
     iro::whitelist_new();
 
     auto d = std::distance(first, last);
-    if (d <= cutoff) {
-      for_each_serial<P, Mode>(first, last, f, cutoff);
+    if (!sp.should_split(d)) {
+      for_each_serial<P, Mode>(first, last, f, sp.grain);
       return true;
     } else {
-      auto mid = std::next(first, d / 2);
+      auto d1 = sp.mid(first, d);
+      auto mid = std::next(first, d1);
 
       auto th = madm::uth::thread<void>{};
       bool synched = th.spawn_aux(
         parallel_for_impl<Mode, ForwardIterator, Fn>,
-        std::make_tuple(first, mid, f, cutoff, rh),
+        std::make_tuple(first, mid, f, sp.split(false), rh),
         [=] (bool parent_popped) {
           // on-die callback
           if (parent_popped) {
@@ -1218,7 +2238,7 @@ class ito_pattern_workfirst_lazy {
         iro::acquire(rh);
       }
 
-      synched &= parallel_for_impl<Mode>(mid, last, f, cutoff, rh);
+      synched &= parallel_for_impl<Mode>(mid, last, f, sp.split(!synched), rh);
 
       th.join_aux(0, [&] {
         // on-block callback
@@ -1229,29 +2249,30 @@ class ito_pattern_workfirst_lazy {
     }
   }
 
-  template <access_mode Mode1, access_mode Mode2,
-            typename ForwardIterator1, typename ForwardIterator2, typename Fn>
-  static bool parallel_for_impl(ForwardIterator1                  first1,
-                                ForwardIterator1                  last1,
-                                ForwardIterator2                  first2,
-                                Fn                                f,
-                                iterator_diff_t<ForwardIterator1> cutoff,
-                                typename iro::release_handler     rh) {
+  template <access_mode... Modes,
+            typename ForwardIterator1, typename... ForwardIterators, typename Fn>
+  static bool parallel_for_impl(ForwardIterator1                            first1,
+                                ForwardIterator1                            last1,
+                                std::tuple<ForwardIterators...>             firsts,
+                                Fn                                          f,
+                                splitter<iterator_diff_t<ForwardIterator1>> sp,
+                                typename iro::release_handler               rh) {
     iro::poll();
 
     auto d = std::distance(first1, last1);
-    if (d <= cutoff) {
-      for_each_serial<P, Mode1, Mode2>(first1, last1, first2, f, cutoff);
+    if (!sp.should_split(d)) {
+      for_each_serial_n<P, Modes...>(first1, last1, firsts, f, sp.grain);
       return true;
     } else {
-      auto mid1 = std::next(first1, d / 2);
+      auto d1 = sp.mid(first1, d);
+      auto mid1 = std::next(first1, d1);
 
       iro::whitelist_new();
 
       auto th = madm::uth::thread<void>{};
       bool synched = th.spawn_aux(
-        parallel_for_impl<Mode1, Mode2, ForwardIterator1, ForwardIterator2, Fn>,
-        std::make_tuple(first1, mid1, first2, f, cutoff, rh),
+        [](auto... args) { return parallel_for_impl<Modes...>(args...); },
+        std::make_tuple(first1, mid1, firsts, f, sp.split(false), rh),
         [=] (bool parent_popped) {
           // on-die callback
           if (parent_popped) {
@@ -1266,8 +2287,8 @@ class ito_pattern_workfirst_lazy {
         iro::acquire(rh);
       }
 
-      auto mid2 = std::next(first2, d / 2);
-      synched &= parallel_for_impl<Mode1, Mode2>(mid1, last1, mid2, f, cutoff, rh);
+      auto mids = next_all(firsts, d1);
+      synched &= parallel_for_impl<Modes...>(mid1, last1, mids, f, sp.split(!synched), rh);
 
       th.join_aux(0, [&] {
         // on-block callback
@@ -1280,35 +2301,36 @@ class ito_pattern_workfirst_lazy {
 
   template <bool TopLevel, typename ForwardIterator, typename T, typename ReduceOp, typename TransformOp>
   static std::conditional_t<TopLevel, std::tuple<T, bool>, T>
-  parallel_reduce_impl(ForwardIterator                  first,
-                       ForwardIterator                  last,
-                       T                                init,
-                       ReduceOp                         reduce,
-                       TransformOp                      transform,
-                       iterator_diff_t<ForwardIterator> cutoff,
-                       typename iro::release_handler    rh) {
+  parallel_reduce_impl(ForwardIterator                            first,
+                       ForwardIterator                            last,
+                       T                                          init,
+                       ReduceOp                                   reduce,
+                       TransformOp                                transform,
+                       splitter<iterator_diff_t<ForwardIterator>> sp,
+                       typename iro::release_handler              rh) {
     iro::poll();
 
     auto d = std::distance(first, last);
-    if (d <= cutoff) {
+    if (!sp.should_split(d)) {
       T acc = init;
       for_each_serial<P, access_mode::read>(first, last, [&](const auto& v) {
         acc = reduce(acc, transform(v));
-      }, cutoff);
+      }, sp.grain);
       if constexpr (TopLevel) {
         return {acc, true};
       } else {
         return acc;
       }
     } else {
-      auto mid = std::next(first, d / 2);
+      auto d1 = sp.mid(first, d);
+      auto mid = std::next(first, d1);
 
       iro::whitelist_new();
 
       auto th = madm::uth::thread<T>{};
       bool synched = th.spawn_aux(
         parallel_reduce_impl<false, ForwardIterator, T, ReduceOp, TransformOp>,
-        std::make_tuple(first, mid, init, reduce, transform, cutoff, rh),
+        std::make_tuple(first, mid, init, reduce, transform, sp.split(false), rh),
         [=] (bool parent_popped) {
           // on-die callback
           if (parent_popped) {
@@ -1323,7 +2345,7 @@ class ito_pattern_workfirst_lazy {
         iro::acquire(rh);
       }
 
-      auto ret2 = parallel_reduce_impl<TopLevel>(mid, last, init, reduce, transform, cutoff, rh);
+      auto ret2 = parallel_reduce_impl<TopLevel>(mid, last, init, reduce, transform, sp.split(!synched), rh);
 
       auto acc1 = th.join_aux(0, [&] {
         // on-block callback
@@ -1340,31 +2362,108 @@ class ito_pattern_workfirst_lazy {
     }
   }
 
+  // The accumulator is moved into the spawned task. If the continuation is not stolen,
+  // the task has completed and its accumulator is reused for the rest of the range;
+  // otherwise the continuation starts from a new identity and the results are merged.
+  template <bool TopLevel, typename ForwardIterator, typename T,
+            typename IdentityFn, typename AccumulateOp, typename ReduceOp>
+  static std::conditional_t<TopLevel, std::tuple<T, bool>, T>
+  parallel_reduce_inplace_impl(ForwardIterator                            first,
+                               ForwardIterator                            last,
+                               T                                          acc,
+                               IdentityFn                                 identity,
+                               AccumulateOp                               accumulate,
+                               ReduceOp                                   reduce,
+                               splitter<iterator_diff_t<ForwardIterator>> sp,
+                               typename iro::release_handler              rh) {
+    iro::poll();
+
+    auto d = std::distance(first, last);
+    if (!sp.should_split(d)) {
+      for_each_serial<P, access_mode::read>(first, last, [&](const auto& v) {
+        accumulate(acc, v);
+      }, sp.grain);
+      if constexpr (TopLevel) {
+        return {std::move(acc), true};
+      } else {
+        return acc;
+      }
+    } else {
+      auto d1 = sp.mid(first, d);
+      auto mid = std::next(first, d1);
+
+      iro::whitelist_new();
+
+      auto th = madm::uth::thread<T>{};
+      bool synched = th.spawn_aux(
+        parallel_reduce_inplace_impl<false, ForwardIterator, T, IdentityFn, AccumulateOp, ReduceOp>,
+        std::make_tuple(first, mid, std::move(acc), identity, accumulate, reduce, sp.split(false), rh),
+        [=] (bool parent_popped) {
+          // on-die callback
+          if (parent_popped) {
+            iro::whitelist_merge();
+          } else {
+            iro::release();
+          }
+        }
+      );
+      if (!synched) {
+        iro::whitelist_clear();
+        iro::acquire(rh);
+      }
+
+      auto on_block = [] {
+        // on-block callback
+        iro::release();
+      };
+
+      if (synched) {
+        T acc1 = th.join_aux(0, on_block);
+        return parallel_reduce_inplace_impl<TopLevel>(mid, last, std::move(acc1), identity, accumulate, reduce,
+                                                      sp.split(false), rh);
+      }
+
+      auto ret2 = parallel_reduce_inplace_impl<TopLevel>(mid, last, identity(), identity, accumulate, reduce,
+                                                         sp.split(true), rh);
+
+      T acc1 = th.join_aux(0, on_block);
+
+      if constexpr (TopLevel) {
+        reduce(acc1, std::as_const(std::get<0>(ret2)));
+        return {std::move(acc1), false};
+      } else {
+        reduce(acc1, std::as_const(ret2));
+        return acc1;
+      }
+    }
+  }
+
   template <typename ForwardIterator, typename ForwardIteratorR, class UnaryOp>
-  static bool parallel_transform_impl(ForwardIterator                  first,
-                                      ForwardIterator                  last,
-                                      ForwardIteratorR                 result,
-                                      UnaryOp                          unary_op,
-                                      iterator_diff_t<ForwardIterator> cutoff,
-                                      typename iro::release_handler    rh) {
+  static bool parallel_transform_impl(ForwardIterator                            first,
+                                      ForwardIterator                            last,
+                                      ForwardIteratorR                           result,
+                                      UnaryOp                                    unary_op,
+                                      splitter<iterator_diff_t<ForwardIterator>> sp,
+                                      typename iro::release_handler              rh) {
     iro::poll();
 
     auto d = std::distance(first, last);
-    if (d <= cutoff) {
+    if (!sp.should_split(d)) {
       for_each_serial<P, access_mode::read, access_mode::write>(
           first, last, result, [&](const auto& v, auto&& r) {
         r = unary_op(v);
-      }, cutoff);
+      }, sp.grain);
       return true;
     } else {
-      auto mid = std::next(first, d / 2);
+      auto d1 = sp.mid(first, d);
+      auto mid = std::next(first, d1);
 
       iro::whitelist_new();
 
       auto th = madm::uth::thread<void>{};
       bool synched = th.spawn_aux(
         parallel_transform_impl<ForwardIterator, ForwardIteratorR, UnaryOp>,
-        std::make_tuple(first, mid, result, unary_op, cutoff, rh),
+        std::make_tuple(first, mid, result, unary_op, sp.split(false), rh),
         [=] (bool parent_popped) {
           // on-die callback
           if (parent_popped) {
@@ -1379,8 +2478,8 @@ class ito_pattern_workfirst_lazy {
         iro::acquire(rh);
       }
 
-      auto result_mid = std::next(result, d / 2);
-      synched &= parallel_transform_impl(mid, last, result_mid, unary_op, cutoff, rh);
+      auto result_mid = std::next(result, d1);
+      synched &= parallel_transform_impl(mid, last, result_mid, unary_op, sp.split(!synched), rh);
 
       th.join_aux(0, [&] {
         // on-block callback
@@ -1392,31 +2491,32 @@ class ito_pattern_workfirst_lazy {
   }
 
   template <typename ForwardIterator1, typename ForwardIterator2, typename ForwardIteratorR, class BinaryOp>
-  static bool parallel_transform_impl(ForwardIterator1                  first1,
-                                      ForwardIterator1                  last1,
-                                      ForwardIterator2                  first2,
-                                      ForwardIteratorR                  result,
-                                      BinaryOp                          binary_op,
-                                      iterator_diff_t<ForwardIterator1> cutoff,
-                                      typename iro::release_handler     rh) {
+  static bool parallel_transform_impl(ForwardIterator1                            first1,
+                                      ForwardIterator1                            last1,
+                                      ForwardIterator2                            first2,
+                                      ForwardIteratorR                            result,
+                                      BinaryOp                                    binary_op,
+                                      splitter<iterator_diff_t<ForwardIterator1>> sp,
+                                      typename iro::release_handler               rh) {
     iro::poll();
 
     auto d = std::distance(first1, last1);
-    if (d <= cutoff) {
+    if (!sp.should_split(d)) {
       for_each_serial<P, access_mode::read, access_mode::read, access_mode::write>(
           first1, last1, first2, result, [&](const auto& v1, const auto& v2, auto&& r) {
         r = binary_op(v1, v2);
-      }, cutoff);
+      }, sp.grain);
       return true;
     } else {
-      auto mid1 = std::next(first1, d / 2);
+      auto d1 = sp.mid(first1, d);
+      auto mid1 = std::next(first1, d1);
 
       iro::whitelist_new();
 
       auto th = madm::uth::thread<void>{};
       bool synched = th.spawn_aux(
         parallel_transform_impl<ForwardIterator1, ForwardIterator2, ForwardIteratorR, BinaryOp>,
-        std::make_tuple(first1, mid1, first2, result, binary_op, cutoff, rh),
+        std::make_tuple(first1, mid1, first2, result, binary_op, sp.split(false), rh),
         [=] (bool parent_popped) {
           // on-die callback
           if (parent_popped) {
@@ -1431,9 +2531,9 @@ class ito_pattern_workfirst_lazy {
         iro::acquire(rh);
       }
 
-      auto mid2 = std::next(first2, d / 2);
-      auto result_mid = std::next(result, d / 2);
-      synched &= parallel_transform_impl(mid1, last1, mid2, result_mid, binary_op, cutoff, rh);
+      auto mid2 = std::next(first2, d1);
+      auto result_mid = std::next(result, d1);
+      synched &= parallel_transform_impl(mid1, last1, mid2, result_mid, binary_op, sp.split(!synched), rh);
 
       th.join_aux(0, [&] {
         // on-block callback
@@ -1444,6 +2544,71 @@ class ito_pattern_workfirst_lazy {
     }
   }
 
+  template <bool TopLevel, typename ForwardIterator, typename Predicate>
+  static std::conditional_t<TopLevel,
+                            std::tuple<iterator_diff_t<ForwardIterator>, bool>,
+                            iterator_diff_t<ForwardIterator>>
+  parallel_find_if_impl(ForwardIterator                                 first,
+                        ForwardIterator                                 last,
+                        iterator_diff_t<ForwardIterator>                offset,
+                        Predicate                                       pred,
+                        iterator_diff_t<ForwardIterator>                cutoff,
+                        find_index<P, iterator_diff_t<ForwardIterator>> found,
+                        bool                                            stolen,
+                        typename iro::release_handler                   rh) {
+    iro::poll();
+
+    auto d = std::distance(first, last);
+    // The hint is read at leaves, and by continuations that were stolen and may have become
+    // useless while they were waiting; other internal nodes do not read it.
+    if (d <= cutoff || (stolen && found.get() <= offset)) {
+      auto i = find_if_serial<P>(first, last, offset, found.none(), pred, cutoff,
+                                 [&](auto j) { return found.get() <= j; });
+      found.update(i);
+      if constexpr (TopLevel) {
+        return {i, true};
+      } else {
+        return i;
+      }
+    } else {
+      auto mid = std::next(first, d / 2);
+
+      iro::whitelist_new();
+
+      auto th = madm::uth::thread<iterator_diff_t<ForwardIterator>>{};
+      bool synched = th.spawn_aux(
+        parallel_find_if_impl<false, ForwardIterator, Predicate>,
+        std::make_tuple(first, mid, offset, pred, cutoff, found, false, rh),
+        [=] (bool parent_popped) {
+          // on-die callback
+          if (parent_popped) {
+            iro::whitelist_merge();
+          } else {
+            iro::release();
+          }
+        }
+      );
+      if (!synched) {
+        iro::whitelist_clear();
+        iro::acquire(rh);
+      }
+
+      auto ret2 = parallel_find_if_impl<TopLevel>(mid, last, offset + d / 2, pred, cutoff, found, !synched, rh);
+
+      auto i1 = th.join_aux(0, [&] {
+        // on-block callback
+        iro::release();
+      });
+
+      if constexpr (TopLevel) {
+        auto [i2, synched2] = ret2;
+        return {std::min(i1, i2), synched & synched2};
+      } else {
+        return std::min(i1, ret2);
+      }
+    }
+  }
+
 public:
   template <typename Fn, typename... Args>
   static auto root_spawn(Fn&& f, Args&&... args) {
@@ -1456,7 +2621,7 @@ public:
       th.join();
       iro::acquire();
     } else {
-      auto&& ret = th.join();
+      ret_t ret = th.join();
       iro::acquire_whitelist();
       return ret;
     }
@@ -1487,7 +2652,7 @@ public:
 
     typename iro::release_handler rh;
     iro::release_lazy(&rh);
-    bool synched = parallel_for_impl<Mode>(first, last, f, cutoff, rh);
+    bool synched = parallel_for_impl<Mode>(first, last, f, make_splitter<P, ForwardIterator>(cutoff), rh);
     if (!synched) {
       iro::acquire_whitelist();
     }
@@ -1495,18 +2660,18 @@ public:
     iro::poll();
   }
 
-  template <access_mode Mode1, access_mode Mode2,
-            typename ForwardIterator1, typename ForwardIterator2, typename Fn>
+  template <access_mode... Modes,
+            typename ForwardIterator1, typename... ForwardIterators, typename Fn>
   static void parallel_for(ForwardIterator1                  first1,
                            ForwardIterator1                  last1,
-                           ForwardIterator2                  first2,
+                           std::tuple<ForwardIterators...>   firsts,
                            Fn                                f,
                            iterator_diff_t<ForwardIterator1> cutoff) {
     iro::poll();
 
     typename iro::release_handler rh;
     iro::release_lazy(&rh);
-    bool synched = parallel_for_impl<Mode1, Mode2>(first1, last1, first2, f, cutoff, rh);
+    bool synched = parallel_for_impl<Modes...>(first1, last1, firsts, f, make_splitter<P, ForwardIterator1>(cutoff), rh);
     if (!synched) {
       iro::acquire_whitelist();
     }
@@ -1525,7 +2690,7 @@ public:
 
     typename iro::release_handler rh;
     iro::release_lazy(&rh);
-    auto [ret, synched] = parallel_reduce_impl<true>(first, last, init, reduce, transform, cutoff, rh);
+    auto [ret, synched] = parallel_reduce_impl<true>(first, last, init, reduce, transform, make_splitter<P, ForwardIterator>(cutoff), rh);
     if (!synched) {
       iro::acquire_whitelist();
     }
@@ -1535,6 +2700,28 @@ public:
     return ret;
   }
 
+  template <typename ForwardIterator, typename IdentityFn, typename AccumulateOp, typename ReduceOp>
+  static auto parallel_reduce_inplace(ForwardIterator                  first,
+                                      ForwardIterator                  last,
+                                      IdentityFn                       identity,
+                                      AccumulateOp                     accumulate,
+                                      ReduceOp                         reduce,
+                                      iterator_diff_t<ForwardIterator> cutoff) {
+    iro::poll();
+
+    typename iro::release_handler rh;
+    iro::release_lazy(&rh);
+    auto [ret, synched] = parallel_reduce_inplace_impl<true>(first, last, identity(), identity, accumulate, reduce,
+                                                             make_splitter<P, ForwardIterator>(cutoff), rh);
+    if (!synched) {
+      iro::acquire_whitelist();
+    }
+
+    iro::poll();
+
+    return std::move(ret);
+  }
+
   template <typename ForwardIterator, typename ForwardIteratorR, class UnaryOp>
   static ForwardIteratorR parallel_transform(ForwardIterator                  first,
                                              ForwardIterator                  last,
@@ -1545,7 +2732,7 @@ public:
 
     typename iro::release_handler rh;
     iro::release_lazy(&rh);
-    bool synched = parallel_transform_impl(first, last, result, unary_op, cutoff, rh);
+    bool synched = parallel_transform_impl(first, last, result, unary_op, make_splitter<P, ForwardIterator>(cutoff), rh);
     if (!synched) {
       iro::acquire_whitelist();
     }
@@ -1567,7 +2754,7 @@ public:
 
     typename iro::release_handler rh;
     iro::release_lazy(&rh);
-    bool synched = parallel_transform_impl(first1, last1, first2, result, binary_op, cutoff, rh);
+    bool synched = parallel_transform_impl(first1, last1, first2, result, binary_op, make_splitter<P, ForwardIterator1>(cutoff), rh);
     if (!synched) {
       iro::acquire_whitelist();
     }
@@ -1578,6 +2765,54 @@ public:
     return std::next(result, d);
   }
 
+  template <typename ForwardIterator, typename ForwardIteratorR, typename BinaryOp, typename T>
+  static ForwardIteratorR parallel_inclusive_scan(ForwardIterator                  first,
+                                                  ForwardIterator                  last,
+                                                  ForwardIteratorR                 result,
+                                                  BinaryOp                         op,
+                                                  std::optional<T>                 init,
+                                                  iterator_diff_t<ForwardIterator> cutoff) {
+    scan_two_pass<P, ito_pattern_workfirst_lazy, true>(first, last, result, init, op, cutoff);
+    auto d = std::distance(first, last);
+    return std::next(result, d);
+  }
+
+  template <typename ForwardIterator, typename ForwardIteratorR, typename T, typename BinaryOp>
+  static ForwardIteratorR parallel_exclusive_scan(ForwardIterator                  first,
+                                                  ForwardIterator                  last,
+                                                  ForwardIteratorR                 result,
+                                                  T                                init,
+                                                  BinaryOp                         op,
+                                                  iterator_diff_t<ForwardIterator> cutoff) {
+    scan_two_pass<P, ito_pattern_workfirst_lazy, false>(first, last, result, std::optional<T>(init), op, cutoff);
+    auto d = std::distance(first, last);
+    return std::next(result, d);
+  }
+
+  template <typename ForwardIterator, typename Predicate>
+  static ForwardIterator parallel_find_if(ForwardIterator                  first,
+                                          ForwardIterator                  last,
+                                          Predicate                        pred,
+                                          iterator_diff_t<ForwardIterator> cutoff) {
+    iro::poll();
+
+    auto d = std::distance(first, last);
+    find_index<P, iterator_diff_t<ForwardIterator>> found(d);
+
+    typename iro::release_handler rh;
+    iro::release_lazy(&rh);
+    auto [i, synched] = parallel_find_if_impl<true>(first, last, 0, pred, cutoff, found, false, rh);
+    if (!synched) {
+      iro::acquire_whitelist();
+    }
+
+    found.destroy();
+
+    iro::poll();
+
+    return std::next(first, i);
+  }
+
 };
 
 struct ito_pattern_policy_default {
@@ -1589,6 +2824,7 @@ struct ito_pattern_policy_default {
   static int n_ranks() { return 1; }
   static void barrier() {}
   static constexpr bool auto_checkout = true;
+  static constexpr bool prefetch_next_chunk = false;
 };
 
 }
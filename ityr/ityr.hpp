@@ -12,9 +12,11 @@
 #include "ityr/iro_ref.hpp"
 #include "ityr/iro_context.hpp"
 #include "ityr/ito_group.hpp"
+#include "ityr/ito_future.hpp"
 #include "ityr/ito_pattern.hpp"
 #include "ityr/logger/logger.hpp"
 #include "ityr/container.hpp"
+#include "ityr/algorithm.hpp"
 
 namespace ityr {
 
@@ -63,6 +65,16 @@ class ityr_if {
   template <std::size_t MaxTasks, bool SpawnLastTask>
   using ito_group_ = ito_group_if<ito_group_policy, MaxTasks, SpawnLastTask>;
 
+  struct ito_future_policy : public ito_future_policy_default {
+    template <typename P_, typename T>
+    using ito_future_impl_t = typename P::template ito_future_t<P_, T>;
+    using iro = iro_;
+    static int rank() { return P::rank(); }
+    static int n_ranks() { return P::n_ranks(); }
+  };
+  template <typename T>
+  using future_ = ito_future_if<ito_future_policy, T>;
+
   struct ito_pattern_policy : public ito_pattern_policy_default {
     template <typename P_>
     using ito_pattern_impl_t = typename P::template ito_pattern_t<P_>;
@@ -72,6 +84,7 @@ class ityr_if {
     static int n_ranks() { return P::n_ranks(); }
     static void barrier() { iro::release(); P::barrier(); iro::acquire(); }
     static constexpr bool auto_checkout = P::auto_checkout;
+    static constexpr bool prefetch_next_chunk = P::prefetch_next_chunk;
   };
   using ito_pattern_ = ito_pattern_if<ito_pattern_policy>;
 
@@ -79,24 +92,44 @@ class ityr_if {
     using iro = iro_;
     using iro_context = iro_context_;
     using ito_pattern = ito_pattern_;
+    static int rank() { return P::rank(); }
+    static int n_ranks() { return P::n_ranks(); }
   };
   using global_container_ = global_container_if<global_container_policy>;
 
+  struct algorithm_policy : public algorithm_policy_default {
+    using iro = iro_;
+    using ito_pattern = ito_pattern_;
+    using global_container = global_container_;
+  };
+  using algorithm_ = algorithm_if<algorithm_policy>;
+
 public:
   using wallclock = typename P::wallclock_t;
   using iro = iro_;
   using iro_context = iro_context_;
   template <std::size_t MaxTasks, bool SpawnLastTask = false>
   using ito_group = ito_group_<MaxTasks, SpawnLastTask>;
+  using ito_dynamic_group = ito_group_<dynamic_tasks, true>;
+  template <typename T>
+  using future = future_<T>;
   using ito_pattern = ito_pattern_;
   using logger_kind = typename P::logger_kind_t::value;
   using logger = logger_;
   template <typename T>
   using global_ptr = typename iro::template global_ptr<T>;
   template <typename T>
+  using global_atomic_ptr = typename iro::template global_atomic_ptr<T>;
+  template <typename T>
   using global_span = typename global_container_::template global_span<T>;
   template <typename T>
   using global_vector = typename global_container_::template global_vector<T>;
+  template <typename T>
+  using global_replica = typename global_container_::template global_replica<T>;
+  using global_pool = typename global_container_::global_pool;
+  template <typename T>
+  using pool = typename global_container_::template pool<T>;
+  using global_arena = typename global_container_::global_arena;
 
   using access_mode = typename iro::access_mode;
 
@@ -118,39 +151,55 @@ public:
     iro::acquire();
   }
 
-  template <access_mode Mode, typename... Args>
-  static auto with_checkout(Args&&... args) {
-    return iro_context::template with_checkout<Mode>(std::forward<Args>(args)...);
-  }
-
-  template <access_mode Mode1, access_mode Mode2, typename... Args>
-  static auto with_checkout(Args&&... args) {
-    return iro_context::template with_checkout<Mode1, Mode2>(std::forward<Args>(args)...);
+  // Collective; see global_replica
+  template <typename T>
+  static global_replica<std::remove_const_t<T>> replicate(global_span<T> s) {
+    return global_replica<std::remove_const_t<T>>(global_span<const T>(s));
   }
 
-  template <access_mode Mode1, access_mode Mode2, access_mode Mode3, typename... Args>
+  template <access_mode... Modes, typename... Args>
   static auto with_checkout(Args&&... args) {
-    return iro_context::template with_checkout<Mode1, Mode2, Mode3>(std::forward<Args>(args)...);
+    return iro_context::template with_checkout<Modes...>(std::forward<Args>(args)...);
   }
 
-  template <access_mode Mode, typename... Args>
+  template <access_mode... Modes, typename... Args>
   static auto with_checkout_tied(Args&&... args) {
-    return iro_context::template with_checkout_tied<Mode>(std::forward<Args>(args)...);
+    return iro_context::template with_checkout_tied<Modes...>(std::forward<Args>(args)...);
   }
 
-  template <access_mode Mode1, access_mode Mode2, typename... Args>
-  static auto with_checkout_tied(Args&&... args) {
-    return iro_context::template with_checkout_tied<Mode1, Mode2>(std::forward<Args>(args)...);
+  template <typename... Args>
+  static auto with_checkout_cancel(Args&&... args) {
+    return iro_context::with_checkout_cancel(std::forward<Args>(args)...);
   }
 
-  template <access_mode Mode1, access_mode Mode2, access_mode Mode3, typename... Args>
-  static auto with_checkout_tied(Args&&... args) {
-    return iro_context::template with_checkout_tied<Mode1, Mode2, Mode3>(std::forward<Args>(args)...);
+  template <typename... Args>
+  static auto fetch_fields(Args&&... args) {
+    return iro::fetch_fields(std::forward<Args>(args)...);
   }
 
   template <typename... Args>
-  static auto with_checkout_cancel(Args&&... args) {
-    return iro_context::with_checkout_cancel(std::forward<Args>(args)...);
+  static auto with_accumulate(Args&&... args) {
+    return iro::with_accumulate(std::forward<Args>(args)...);
+  }
+
+  template <typename T>
+  static T atomic_load(global_atomic_ptr<T> ptr) { return iro::load(ptr); }
+
+  template <typename T>
+  static T atomic_fetch_add(global_atomic_ptr<T> ptr, T val) { return iro::fetch_add(ptr, val); }
+
+  template <typename T>
+  static T atomic_fetch_min(global_atomic_ptr<T> ptr, T val) { return iro::fetch_min(ptr, val); }
+
+  template <typename T>
+  static T atomic_fetch_max(global_atomic_ptr<T> ptr, T val) { return iro::fetch_max(ptr, val); }
+
+  template <typename T>
+  static T atomic_exchange(global_atomic_ptr<T> ptr, T val) { return iro::exchange(ptr, val); }
+
+  template <typename T>
+  static T atomic_compare_exchange(global_atomic_ptr<T> ptr, T expected, T desired) {
+    return iro::compare_exchange(ptr, expected, desired);
   }
 
   template <typename... Args>
@@ -168,6 +217,17 @@ public:
     return ito_pattern::parallel_invoke(std::forward<Args>(args)...);
   }
 
+  template <typename Fn, typename... Args>
+  static auto async(Fn&& f, Args&&... args) {
+    using ret_t = std::invoke_result_t<std::decay_t<Fn>, std::decay_t<Args>...>;
+    return future<ret_t>(std::in_place, std::forward<Fn>(f), std::forward<Args>(args)...);
+  }
+
+  template <typename... Futures>
+  static auto when_all(Futures&&... fs) {
+    return ityr::when_all(fs...);
+  }
+
   template <access_mode Mode, typename... Args>
   static auto serial_for(Args&&... args) {
     return ito_pattern::template serial_for<Mode>(std::forward<Args>(args)...);
@@ -188,15 +248,80 @@ public:
     return ito_pattern::template parallel_for<Mode1, Mode2>(std::forward<Args>(args)...);
   }
 
+  template <access_mode Mode1, access_mode Mode2, access_mode Mode3, access_mode... Modes, typename... Args>
+  static auto parallel_for(Args&&... args) {
+    return ito_pattern::template parallel_for<Mode1, Mode2, Mode3, Modes...>(std::forward<Args>(args)...);
+  }
+
+  template <access_mode Mode, typename... Args>
+  static auto parallel_for_owner(Args&&... args) {
+    return ito_pattern::template parallel_for_owner<Mode>(std::forward<Args>(args)...);
+  }
+
+  template <access_mode Mode1, access_mode Mode2, typename... Args>
+  static auto parallel_for_owner(Args&&... args) {
+    return ito_pattern::template parallel_for_owner<Mode1, Mode2>(std::forward<Args>(args)...);
+  }
+
   template <typename... Args>
   static auto parallel_reduce(Args&&... args) {
     return ito_pattern::parallel_reduce(std::forward<Args>(args)...);
   }
 
+  template <typename... Args>
+  static auto parallel_reduce_inplace(Args&&... args) {
+    return ito_pattern::parallel_reduce_inplace(std::forward<Args>(args)...);
+  }
+
   template <typename... Args>
   static auto parallel_transform(Args&&... args) {
     return ito_pattern::parallel_transform(std::forward<Args>(args)...);
   }
+
+  template <typename... Args>
+  static auto parallel_inclusive_scan(Args&&... args) {
+    return ito_pattern::parallel_inclusive_scan(std::forward<Args>(args)...);
+  }
+
+  template <typename... Args>
+  static auto parallel_exclusive_scan(Args&&... args) {
+    return ito_pattern::parallel_exclusive_scan(std::forward<Args>(args)...);
+  }
+
+  template <typename... Args>
+  static auto parallel_find_if(Args&&... args) {
+    return ito_pattern::parallel_find_if(std::forward<Args>(args)...);
+  }
+
+  template <typename... Args>
+  static auto parallel_any_of(Args&&... args) {
+    return ito_pattern::parallel_any_of(std::forward<Args>(args)...);
+  }
+
+  template <typename... Args>
+  static auto parallel_all_of(Args&&... args) {
+    return ito_pattern::parallel_all_of(std::forward<Args>(args)...);
+  }
+
+  template <typename... Args>
+  static auto parallel_filter(Args&&... args) {
+    return ito_pattern::parallel_filter(std::forward<Args>(args)...);
+  }
+
+  template <typename... Args>
+  static auto parallel_partition(Args&&... args) {
+    return ito_pattern::parallel_partition(std::forward<Args>(args)...);
+  }
+
+  template <typename... Args>
+  static auto parallel_merge(Args&&... args) {
+    return algorithm_::parallel_merge(std::forward<Args>(args)...);
+  }
+
+  template <typename... Args>
+  static auto parallel_sort(Args&&... args) {
+    return algorithm_::parallel_sort(std::forward<Args>(args)...);
+  }
 };
 
 // Serial
@@ -206,6 +331,9 @@ struct ityr_policy_serial {
   template <typename P, std::size_t MaxTasks, bool SpawnLastTask>
   using ito_group_t = ito_group_serial<P, MaxTasks, SpawnLastTask>;
 
+  template <typename P, typename T>
+  using ito_future_t = ito_future_serial<P, T>;
+
   template <typename P>
   using ito_pattern_t = ito_pattern_serial<P>;
 
@@ -233,6 +361,8 @@ struct ityr_policy_serial {
 
   static constexpr bool auto_checkout = true;
 
+  static constexpr bool prefetch_next_chunk = false;
+
   static constexpr bool enable_acquire_whitelist = false;
 };
 
@@ -243,6 +373,9 @@ struct ityr_policy_naive {
   template <typename P, std::size_t MaxTasks, bool SpawnLastTask>
   using ito_group_t = ito_group_naive<P, MaxTasks, SpawnLastTask>;
 
+  template <typename P, typename T>
+  using ito_future_t = ito_future_naive<P, T>;
+
   template <typename P>
   using ito_pattern_t = ito_pattern_naive<P>;
 
@@ -304,6 +437,12 @@ struct ityr_policy_naive {
   static constexpr bool auto_checkout = ITYR_AUTO_CHECKOUT;
 #undef ITYR_AUTO_CHECKOUT
 
+#ifndef ITYR_PREFETCH_NEXT_CHUNK
+#define ITYR_PREFETCH_NEXT_CHUNK false
+#endif
+  static constexpr bool prefetch_next_chunk = ITYR_PREFETCH_NEXT_CHUNK;
+#undef ITYR_PREFETCH_NEXT_CHUNK
+
 #ifndef ITYR_ENABLE_ACQUIRE_WHITELIST
 #define ITYR_ENABLE_ACQUIRE_WHITELIST false
 #endif
@@ -318,6 +457,9 @@ struct ityr_policy_workfirst : public ityr_policy_naive {
   template <typename P, std::size_t MaxTasks, bool SpawnLastTask>
   using ito_group_t = ito_group_workfirst<P, MaxTasks, SpawnLastTask>;
 
+  template <typename P, typename T>
+  using ito_future_t = ito_future_workfirst<P, T>;
+
   template <typename P>
   using ito_pattern_t = ito_pattern_workfirst<P>;
 };
@@ -329,6 +471,9 @@ struct ityr_policy_workfirst_lazy : public ityr_policy_naive {
   template <typename P, std::size_t MaxTasks, bool SpawnLastTask>
   using ito_group_t = ito_group_workfirst_lazy<P, MaxTasks, SpawnLastTask>;
 
+  template <typename P, typename T>
+  using ito_future_t = ito_future_workfirst_lazy<P, T>;
+
   template <typename P>
   using ito_pattern_t = ito_pattern_workfirst_lazy<P>;
 };
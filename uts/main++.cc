@@ -31,6 +31,10 @@ using global_ptr = my_ityr::global_ptr<T>;
 #define UTS_USE_VECTOR 0
 #endif
 
+#ifndef UTS_USE_POOL
+#define UTS_USE_POOL 0
+#endif
+
 #ifndef UTS_REBUILD_TREE
 #define UTS_REBUILD_TREE 0
 #endif
@@ -147,14 +151,23 @@ std::size_t node_size(int n_children) {
 }
 
 global_ptr<dynamic_node> new_dynamic_node(int n_children) {
+#if UTS_USE_POOL
+  auto gptr = global_ptr<dynamic_node>(
+      my_ityr::global_pool::allocate(node_size(n_children)));
+#else
   auto gptr = global_ptr<dynamic_node>(
       my_ityr::iro::malloc_local<std::byte>(node_size(n_children)));
+#endif
   gptr->*(&dynamic_node::n_children) = n_children;
   return gptr;
 }
 
 void delete_dynamic_node(global_ptr<dynamic_node> node, int n_children) {
+#if UTS_USE_POOL
+  my_ityr::global_pool::deallocate(global_ptr<std::byte>(node), node_size(n_children));
+#else
   my_ityr::iro::free(global_ptr<std::byte>(node), node_size(n_children));
+#endif
 }
 
 global_ptr<global_ptr<dynamic_node>> get_children(global_ptr<dynamic_node> node) {
@@ -281,8 +294,16 @@ void uts_run() {
 
     my_ityr::barrier();
     my_ityr::iro::collect_deallocated();
+#if UTS_USE_POOL && !UTS_USE_VECTOR
+    my_ityr::global_pool::collect_deallocated();
+#endif
     my_ityr::barrier();
   }
+
+#if UTS_USE_POOL && !UTS_USE_VECTOR
+  my_ityr::global_pool::release_all();
+  my_ityr::barrier();
+#endif
 }
 
 void real_main(int argc, char *argv[]) {